@@ -0,0 +1,62 @@
+#include "tree.h"
+#include "int.h"
+#include <time.h>
+
+
+/**
+ * Benchmark to AVL tree
+ *
+ * Insert cost and compares from 10^3 to 10^7 keys, in ascending and scrambled order
+*/
+
+
+/**
+ * Scramble the key i (odd multiplier, so it is a permutation of 0..2^32)
+*/
+int scramble(int i) {
+  return (int) ((unsigned) i * 2654435761u);
+}
+
+
+/**
+ * Insert n keys in an empty AVL tree and return the seconds spent
+ * Save the average of compares per insert
+*/
+double bench_insert(int n, int scrambled, double* compares) {
+
+  AVL tree = avl_create(copy_int, destroy_int, compare_int, visit_int);
+  long total = 0;
+
+  clock_t start = clock();
+  for (int i = 0; i < n; i++) {
+    int key = scrambled ? scramble(i) : i;
+    avl_add(tree, &key);
+    total += avl_compares(tree);
+  }
+  double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  *compares = (double) total / n;
+
+  avl_destroy(tree);
+
+  return seconds;
+}
+
+
+int main() {
+
+  printf("%10s %12s %12s %12s %12s %12s %12s\n", "keys", "asc (s)", "asc ns/key", "asc cmp/key",
+    "scr (s)", "scr ns/key", "scr cmp/key");
+
+  for (int n = 1000; n <= 10000000; n *= 10) {
+
+    double ascCompares, scrCompares;
+    double asc = bench_insert(n, false, &ascCompares);
+    double scr = bench_insert(n, true, &scrCompares);
+
+    printf("%10i %12.4f %12.1f %12.2f %12.4f %12.1f %12.2f\n", n, asc, asc * 1e9 / n, ascCompares,
+      scr, scr * 1e9 / n, scrCompares);
+  }
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+#include "hash_probing.h"
+#include "hash_swiss.h"
+#include "int.h"
+#include "mix.h"
+#include <time.h>
+#include <math.h>
+
+
+/**
+ * Benchmark to hash table
+ *
+ * Lookup throughput and probes of hits and misses at some load factors
+ *
+ * Probes of misses and capacity after some churn of deletes and adds
+*/
+
+#define CAPACITY (1 << 20)
+#define LOOKUPS 4000000
+#define CHURN_CAPACITY (1 << 16)
+#define CHURN (1 << 16)
+#define CHURN_LOOKUPS 100000
+#define MAX_PROBES 1024
+#define MAX_LOAD 0.95
+
+
+/**
+ * Scramble the key i (murmur3 finalizer, so different i give different keys)
+*/
+int scramble(int i) {
+  return (int) hash_mix((unsigned) i);
+}
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Fill a table up to the given load factor and save the lookups per second
+ * and the average of probes of keys that are in the table and keys that are not
+*/
+void bench_lookup(ProbingType type, double load, double* hits, double* misses, double* hitProbes, double* missProbes) {
+
+  Hash table = hash_create(CAPACITY, type, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  hash_set_max_load(table, MAX_LOAD);
+
+  int n = (int) (CAPACITY * load);
+  for (int i = 0; i < n; i++) {
+    int key = scramble(i);
+    hash_add(table, &key);
+  }
+
+  int found = 0;
+  long probes = 0;
+  clock_t start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = scramble(i % n);
+    found += hash_search(table, &key) != NULL;
+    probes += hash_probes(table);
+  }
+  *hits = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+  *hitProbes = (double) probes / LOOKUPS;
+
+  probes = 0;
+  start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = scramble(n + i);
+    found += hash_search(table, &key) != NULL;
+    probes += hash_probes(table);
+  }
+  *misses = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+  *missProbes = (double) probes / LOOKUPS;
+
+  if (found != LOOKUPS)
+    printf("Error: %i lookups found, expected %i\n", found, LOOKUPS);
+
+  hash_destroy(table);
+}
+
+
+/**
+ * Same as bench_lookup, with a Swiss hash table
+*/
+void bench_swiss_lookup(double load, double* hits, double* misses) {
+
+  SwissHash table = swiss_create(CAPACITY, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  int n = (int) (CAPACITY * load);
+  for (int i = 0; i < n; i++) {
+    int key = scramble(i);
+    swiss_add(table, &key);
+  }
+
+  int found = 0;
+  clock_t start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = scramble(i % n);
+    found += swiss_search(table, &key) != NULL;
+  }
+  *hits = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = scramble(n + i);
+    found += swiss_search(table, &key) != NULL;
+  }
+  *misses = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  if (found != LOOKUPS)
+    printf("Error: %i lookups found, expected %i\n", found, LOOKUPS);
+
+  swiss_destroy(table);
+}
+
+
+/**
+ * Fill a table up to the given load factor, then delete the oldest key and add
+ * a new one many times, and save the average and 99th percentile of probes of misses
+ * and the capacity at the end
+*/
+void bench_churn(ProbingType type, double load, double* average, int* p99, int* capacity) {
+
+  Hash table = hash_create(CHURN_CAPACITY, type, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  hash_set_max_load(table, MAX_LOAD);
+
+  int n = (int) (CHURN_CAPACITY * load);
+  for (int i = 0; i < n; i++) {
+    int key = scramble(i);
+    hash_add(table, &key);
+  }
+
+  for (int i = 0; i < CHURN; i++) {
+    int key = scramble(i);
+    hash_delete(table, &key);
+    key = scramble(n + i);
+    hash_add(table, &key);
+  }
+
+  // Histogram of probes
+  static long histogram[MAX_PROBES + 1];
+  for (int i = 0; i <= MAX_PROBES; i++) histogram[i] = 0;
+
+  long probes = 0;
+  for (int i = 0; i < CHURN_LOOKUPS; i++) {
+    int key = scramble(n + CHURN + i);
+    hash_search(table, &key);
+    probes += hash_probes(table);
+    histogram[hash_probes(table) < MAX_PROBES ? hash_probes(table) : MAX_PROBES]++;
+  }
+  *average = (double) probes / CHURN_LOOKUPS;
+
+  long count = 0;
+  for (*p99 = 0; count < CHURN_LOOKUPS * 0.99; (*p99)++) count += histogram[*p99];
+  (*p99)--;
+
+  *capacity = hash_capacity(table);
+
+  hash_destroy(table);
+}
+
+
+int main() {
+
+  char* names[] = {"LINEAR", "CUADRATIC", "DOUBLE", "ROBIN_HOOD", "HOPSCOTCH"};
+  ProbingType types[] = {LINEAR, CUADRATIC, DOUBLE_HASHING, ROBIN_HOOD, HOPSCOTCH};
+  double loads[] = {0.5, 0.75, 0.9};
+
+  printf("%12s %6s %16s %16s %12s %12s\n", "probing", "load", "hits (Mops/s)", "misses (Mops/s)",
+    "hit probes", "miss probes");
+
+  for (int t = 0; t < 5; t++) {
+    for (int l = 0; l < 3; l++) {
+
+      double hits, misses, hitProbes, missProbes;
+      bench_lookup(types[t], loads[l], &hits, &misses, &hitProbes, &missProbes);
+
+      printf("%12s %6.2f %16.2f %16.2f %12.2f %12.2f\n", names[t], loads[l], hits / 1e6, misses / 1e6,
+        hitProbes, missProbes);
+    }
+  }
+
+  for (int l = 0; l < 2; l++) {
+
+    double hits, misses;
+    bench_swiss_lookup(loads[l], &hits, &misses);
+
+    printf("%12s %6.2f %16.2f %16.2f %12s %12s\n", "SWISS", loads[l], hits / 1e6, misses / 1e6, "-", "-");
+  }
+
+  // Expected probes with uniform hashing
+  for (int l = 0; l < 3; l++) {
+    printf("%12s %6.2f %16s %16s %12.2f %12.2f\n", "UNIFORM", loads[l], "-", "-",
+      log(1 / (1 - loads[l])) / loads[l], 1 / (1 - loads[l]));
+  }
+
+  printf("\nAfter %i deletes and adds\n", CHURN);
+  printf("%12s %6s %12s %12s %12s\n", "probing", "load", "miss probes", "p99 probes", "capacity");
+
+  for (int t = 0; t < 5; t++) {
+    for (int l = 0; l < 3; l++) {
+
+      double average;
+      int p99, capacity;
+      bench_churn(types[t], loads[l], &average, &p99, &capacity);
+
+      printf("%12s %6.2f %12.2f %12i %12i\n", names[t], loads[l], average, p99, capacity);
+    }
+  }
+
+  return 0;
+}
\ No newline at end of file
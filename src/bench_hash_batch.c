@@ -0,0 +1,97 @@
+#include "hash_probing.h"
+#include "int.h"
+#include "mix.h"
+#include <time.h>
+
+
+/**
+ * Benchmark to hash table batch search
+ *
+ * Lookup throughput of keys searched one by one and by hash_search_batch,
+ * on a table much bigger than the cache
+*/
+
+#define CAPACITY (1 << 24)
+#define KEYS 12000000
+#define LOOKUPS 4000000
+
+
+/**
+ * Scramble the key i (murmur3 finalizer, so different i give different keys)
+*/
+int scramble(int i) {
+  return (int) hash_mix((unsigned) i);
+}
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Fill a table and save the lookups per second searching one by one and by batches
+*/
+void bench_batch(ProbingType type, int* keys, void* *pointers, void* *out, double* single, double* batch) {
+
+  Hash table = hash_create(CAPACITY, type, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  for (int i = 0; i < KEYS; i++) {
+    int key = scramble(i);
+    hash_add(table, &key);
+  }
+
+  // Half of the lookups are hits and half misses, in random order
+  for (int i = 0; i < LOOKUPS; i++) {
+    keys[i] = scramble(i % 2 ? (int) ((unsigned) scramble(i) % KEYS) : KEYS + i);
+    pointers[i] = &keys[i];
+  }
+
+  int found = 0;
+  clock_t start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    found += hash_search(table, pointers[i]) != NULL;
+  }
+  *single = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  start = clock();
+  hash_search_batch(table, pointers, LOOKUPS, out);
+  *batch = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  for (int i = 0; i < LOOKUPS; i++) found -= out[i] != NULL;
+
+  if (found != 0)
+    printf("Error: batch search found %i keys less than one by one\n", found);
+
+  hash_destroy(table);
+}
+
+
+int main() {
+
+  char* names[] = {"LINEAR", "DOUBLE", "ROBIN_HOOD"};
+  ProbingType types[] = {LINEAR, DOUBLE_HASHING, ROBIN_HOOD};
+
+  int* keys = malloc(sizeof(int) * LOOKUPS);
+  void* *pointers = malloc(sizeof(void*) * LOOKUPS);
+  void* *out = malloc(sizeof(void*) * LOOKUPS);
+
+  printf("%12s %16s %16s %8s\n", "probing", "single (Mops/s)", "batch (Mops/s)", "speedup");
+
+  for (int t = 0; t < 3; t++) {
+
+    double single, batch;
+    bench_batch(types[t], keys, pointers, out, &single, &batch);
+
+    printf("%12s %16.2f %16.2f %8.2f\n", names[t], single / 1e6, batch / 1e6, batch / single);
+  }
+
+  free(keys);
+  free(pointers);
+  free(out);
+
+  return 0;
+}
\ No newline at end of file
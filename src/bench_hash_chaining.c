@@ -0,0 +1,86 @@
+#include "hash_chaining.h"
+#include "int.h"
+#include <time.h>
+
+
+/**
+ * Benchmark to hash table with separate chaining
+ *
+ * Histogram of insert latency, rehashing at once and incrementally
+*/
+
+#define INSERTS 4000000
+#define BUCKETS 32
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Return the current time in nanoseconds
+*/
+long now() {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000000000L + time.tv_nsec;
+}
+
+
+/**
+ * Insert keys in the empty table and fill the histogram of latency
+ * (the bucket i counts the inserts that took between 2^i and 2^(i+1) ns)
+ * Return the max latency
+*/
+long bench_insert(ChainingHash table, long* histogram) {
+
+  for (int i = 0; i < BUCKETS; i++) histogram[i] = 0;
+
+  long max = 0;
+  for (int i = 0; i < INSERTS; i++) {
+
+    long start = now();
+    chaining_add(table, &i);
+    long latency = now() - start;
+
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 and (1L << (bucket + 1)) <= latency) bucket++;
+    histogram[bucket]++;
+
+    if (latency > max) max = latency;
+  }
+
+  return max;
+}
+
+
+int main() {
+
+  long atOnce[BUCKETS], incremental[BUCKETS];
+
+  // Both tables are destroyed at the end, so frees of one dont slow down the other
+  ChainingHash tableAtOnce = chaining_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  ChainingHash tableIncremental = chaining_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  chaining_set_incremental(tableIncremental, 4);
+
+  long maxAtOnce = bench_insert(tableAtOnce, atOnce);
+  long maxIncremental = bench_insert(tableIncremental, incremental);
+
+  printf("%16s %12s %12s\n", "latency (ns)", "at once", "incremental");
+
+  for (int i = 0; i < BUCKETS; i++) {
+    if (atOnce[i] or incremental[i])
+      printf("%16ld %12ld %12ld\n", 1L << i, atOnce[i], incremental[i]);
+  }
+
+  printf("%16s %12ld %12ld\n", "max", maxAtOnce, maxIncremental);
+
+  chaining_destroy(tableAtOnce);
+  chaining_destroy(tableIncremental);
+
+  return 0;
+}
\ No newline at end of file
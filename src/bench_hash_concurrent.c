@@ -0,0 +1,189 @@
+#include "hash_concurrent.h"
+#include "hash_lockfree.h"
+#include "hash_chaining.h"
+#include "int.h"
+#include <time.h>
+
+
+/**
+ * Benchmark to concurrent hash table
+ *
+ * Throughput of a mix of searches, adds and deletes from some threads, on a
+ * chaining hash table behind one global lock, on the striped concurrent one
+ * and on the lock free one
+*/
+
+#define KEYS (1 << 16)
+#define OPS 4000000
+#define MAX_THREADS 32
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Return the current time in nanoseconds
+*/
+long now() {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000000000L + time.tv_nsec;
+}
+
+
+/**
+ * Work of each thread: some random operations, reads with the given percentage
+ * and the writes half adds and half deletes
+*/
+typedef struct {
+  ChainingHash locked;
+  pthread_mutex_t* mutex;
+  CHash striped;
+  LHash lockFree;
+  int reads;
+  int ops;
+  unsigned seed;
+} Work;
+
+
+/**
+ * Next random number (xorshift)
+*/
+unsigned next(unsigned* seed) {
+  *seed ^= *seed << 13;
+  *seed ^= *seed >> 17;
+  *seed ^= *seed << 5;
+  return *seed;
+}
+
+
+/**
+ * Run the operations on the table behind the global lock
+*/
+void* run_locked(void* argument) {
+
+  Work* work = argument;
+
+  for (int i = 0; i < work->ops; i++) {
+
+    unsigned r = next(&work->seed);
+    int key = r % KEYS;
+    int op = (r >> 16) % 100;
+
+    pthread_mutex_lock(work->mutex);
+    if (op < work->reads) chaining_search(work->locked, &key);
+    else if (op % 2) chaining_add(work->locked, &key);
+    else chaining_delete(work->locked, &key);
+    pthread_mutex_unlock(work->mutex);
+  }
+
+  return NULL;
+}
+
+
+/**
+ * Run the operations on the striped table
+*/
+void* run_striped(void* argument) {
+
+  Work* work = argument;
+
+  for (int i = 0; i < work->ops; i++) {
+
+    unsigned r = next(&work->seed);
+    int key = r % KEYS;
+    int op = (r >> 16) % 100;
+
+    if (op < work->reads) chash_contains(work->striped, &key);
+    else if (op % 2) chash_add(work->striped, &key);
+    else chash_delete(work->striped, &key);
+  }
+
+  return NULL;
+}
+
+
+/**
+ * Run the operations on the lock free table
+*/
+void* run_lock_free(void* argument) {
+
+  Work* work = argument;
+
+  for (int i = 0; i < work->ops; i++) {
+
+    unsigned r = next(&work->seed);
+    int key = r % KEYS;
+    int op = (r >> 16) % 100;
+
+    if (op < work->reads) lfhash_contains(work->lockFree, &key);
+    else if (op % 2) lfhash_add(work->lockFree, &key);
+    else lfhash_delete(work->lockFree, &key);
+  }
+
+  return NULL;
+}
+
+
+/**
+ * Run OPS operations split in the given amount of threads, with the given
+ * percentage of reads, and return the operations per second
+*/
+double bench_mix(int threads, int reads, void* (*run)(void*)) {
+
+  ChainingHash locked = chaining_create(KEYS, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  CHash table = chash_create(KEYS, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  LHash lockFree = lfhash_create(KEYS, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+  // Half of the keys in the table
+  for (int key = 0; key < KEYS; key += 2) {
+    chaining_add(locked, &key);
+    chash_add(table, &key);
+    lfhash_add(lockFree, &key);
+  }
+
+  pthread_t ids[MAX_THREADS];
+  Work works[MAX_THREADS];
+
+  long start = now();
+  for (int i = 0; i < threads; i++) {
+    works[i] = (Work) {locked, &mutex, table, lockFree, reads, OPS / threads, 2463534242u + i};
+    pthread_create(&ids[i], NULL, run, &works[i]);
+  }
+  for (int i = 0; i < threads; i++) pthread_join(ids[i], NULL);
+  double seconds = (now() - start) / 1e9;
+
+  chaining_destroy(locked);
+  chash_destroy(table);
+  lfhash_destroy(lockFree);
+
+  return OPS / seconds;
+}
+
+
+int main() {
+
+  int mixes[] = {90, 50};
+
+  printf("%8s %8s %18s %18s %18s\n", "reads %", "threads", "global (Mops/s)", "striped (Mops/s)",
+    "lock free (Mops/s)");
+
+  for (int m = 0; m < 2; m++) {
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+
+      double global = bench_mix(threads, mixes[m], run_locked);
+      double striped = bench_mix(threads, mixes[m], run_striped);
+      double lockFree = bench_mix(threads, mixes[m], run_lock_free);
+
+      printf("%8i %8i %18.2f %18.2f %18.2f\n", mixes[m], threads, global / 1e6, striped / 1e6, lockFree / 1e6);
+    }
+  }
+
+  return 0;
+}
\ No newline at end of file
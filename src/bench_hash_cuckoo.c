@@ -0,0 +1,90 @@
+#include "hash_cuckoo.h"
+#include "int.h"
+#include "mix.h"
+#include <time.h>
+
+
+/**
+ * Benchmark to cuckoo hash table
+ *
+ * Kicks of the adds and lookup throughput of hits and misses at some load factors
+*/
+
+#define CAPACITY (1 << 20)
+#define LOOKUPS 4000000
+
+
+/**
+ * Scramble the key i (murmur3 finalizer, so different i give different keys)
+*/
+int scramble(int i) {
+  return (int) hash_mix((unsigned) i);
+}
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Fill a table up to the given load factor and save the average and max of kicks
+ * of the adds, and the lookups per second of keys that are in the table and keys that are not
+*/
+void bench_cuckoo(double load, double* kicks, int* maxKicks, double* hits, double* misses) {
+
+  CuckooHash table = cuckoo_create(CAPACITY, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  int n = (int) (CAPACITY * load);
+  long totalKicks = 0;
+  *maxKicks = 0;
+  for (int i = 0; i < n; i++) {
+    int key = scramble(i);
+    cuckoo_add(table, &key);
+    totalKicks += cuckoo_kicks(table);
+    if (cuckoo_kicks(table) > *maxKicks) *maxKicks = cuckoo_kicks(table);
+  }
+  *kicks = (double) totalKicks / n;
+
+  int found = 0;
+  clock_t start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = scramble(i % n);
+    found += cuckoo_search(table, &key) != NULL;
+  }
+  *hits = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int key = scramble(n + i);
+    found += cuckoo_search(table, &key) != NULL;
+  }
+  *misses = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  if (found != LOOKUPS)
+    printf("Error: %i lookups found, expected %i\n", found, LOOKUPS);
+
+  cuckoo_destroy(table);
+}
+
+
+int main() {
+
+  double loads[] = {0.5, 0.75, 0.9};
+
+  printf("%6s %12s %12s %16s %16s\n", "load", "avg kicks", "max kicks", "hits (Mops/s)", "misses (Mops/s)");
+
+  for (int l = 0; l < 3; l++) {
+
+    double kicks, hits, misses;
+    int maxKicks;
+    bench_cuckoo(loads[l], &kicks, &maxKicks, &hits, &misses);
+
+    printf("%6.2f %12.3f %12i %16.2f %16.2f\n", loads[l], kicks, maxKicks, hits / 1e6, misses / 1e6);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "hash_chaining.h"
+#include "hash_probing.h"
+#include "int.h"
+#include "mix.h"
+#include <time.h>
+
+
+/**
+ * Benchmark to hash table indexing
+ *
+ * Lookup throughput and distribution of the keys in the cells of the chaining and
+ * the linear probing tables, indexing with the modulo of the hash (at a power of two
+ * and at a prime capacity) and with a mask of the mixed hash (power of two mode)
+ *
+ * The hash is the value of the key, so keys with a stride are a weak hash
+*/
+
+#define CAPACITY (1 << 20)
+#define PRIME_CAPACITY 1048573
+#define KEYS 750000
+#define LOOKUPS 4000000
+#define STRIDE 64
+
+
+/**
+ * Scramble the key i (murmur3 finalizer, so different i give different keys)
+*/
+int scramble(int i) {
+  return (int) hash_mix((unsigned) i);
+}
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Return the key i, scrambled or with a stride
+*/
+int key(int i, int strided) {
+  return strided ? i * STRIDE : scramble(i);
+}
+
+
+/**
+ * Fill a table with the keys and save the lookups per second,
+ * the longest list and the percentage of empty cells
+*/
+void bench_index(int capacity, int powerOfTwo, int strided, double* lookups, int* longest, double* empty) {
+
+  ChainingHash table = chaining_create(capacity, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  chaining_set_power_of_two(table, powerOfTwo);
+
+  for (int i = 0; i < KEYS; i++) {
+    int k = key(i, strided);
+    chaining_add(table, &k);
+  }
+
+  int found = 0;
+  clock_t start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int k = key(i % KEYS, strided);
+    found += chaining_search(table, &k) != NULL;
+  }
+  *lookups = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  if (found != LOOKUPS)
+    printf("Error: %i lookups found, expected %i\n", found, LOOKUPS);
+
+  // Distribution of the keys in the cells
+  int emptyCells = 0;
+  *longest = 0;
+  for (int i = 0; i < chaining_capacity(table); i++) {
+    int length = 0;
+    for (HList node = table->array[i]; node exist; node = node->next) length++;
+    if (length == 0) emptyCells++;
+    if (length > *longest) *longest = length;
+  }
+  *empty = 100.0 * emptyCells / chaining_capacity(table);
+
+  chaining_destroy(table);
+}
+
+
+/**
+ * Fill a linear probing table with the keys and save the lookups per second,
+ * the longest cluster and the percentage of empty cells
+*/
+void bench_probing_index(int capacity, int powerOfTwo, int strided, double* lookups, int* longest, double* empty) {
+
+  Hash table = hash_create(capacity, LINEAR, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  hash_set_power_of_two(table, powerOfTwo);
+
+  for (int i = 0; i < KEYS; i++) {
+    int k = key(i, strided);
+    hash_add(table, &k);
+  }
+
+  int found = 0;
+  clock_t start = clock();
+  for (int i = 0; i < LOOKUPS; i++) {
+    int k = key(i % KEYS, strided);
+    found += hash_search(table, &k) != NULL;
+  }
+  *lookups = LOOKUPS / ((double) (clock() - start) / CLOCKS_PER_SEC);
+
+  if (found != LOOKUPS)
+    printf("Error: %i lookups found, expected %i\n", found, LOOKUPS);
+
+  // Distribution of the keys in the cells (the clusters dont wrap, so the first one may be cut)
+  int emptyCells = 0, length = 0;
+  *longest = 0;
+  for (int i = 0; i < hash_capacity(table); i++) {
+    length = table->array[i].data exist ? length + 1 : 0;
+    if (length == 0) emptyCells++;
+    if (length > *longest) *longest = length;
+  }
+  *empty = 100.0 * emptyCells / hash_capacity(table);
+
+  hash_destroy(table);
+}
+
+
+int main() {
+
+  char* names[] = {"MODULO 2^20", "MODULO PRIME", "POWER_OF_TWO"};
+  int capacities[] = {CAPACITY, PRIME_CAPACITY, CAPACITY};
+  int powersOfTwo[] = {false, false, true};
+  char* keys[] = {"scrambled", "strided"};
+
+  char* tables[] = {"chaining", "linear"};
+
+  printf("%10s %14s %10s %16s %10s %10s\n", "table", "indexing", "keys", "lookups (Mops/s)", "longest", "empty (%)");
+
+  for (int t = 0; t < 2; t++) {
+    for (int s = 0; s < 2; s++) {
+      for (int m = 0; m < 3; m++) {
+
+        double lookups, empty;
+        int longest;
+        if (t == 0) bench_index(capacities[m], powersOfTwo[m], s, &lookups, &longest, &empty);
+        else bench_probing_index(capacities[m], powersOfTwo[m], s, &lookups, &longest, &empty);
+
+        printf("%10s %14s %10s %16.2f %10i %10.2f\n", tables[t], names[m], keys[s], lookups / 1e6, longest, empty);
+      }
+    }
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "hash_table.h"
+#include "int.h"
+#include "mix.h"
+#include <time.h>
+#include <malloc.h>
+
+
+/**
+ * Benchmark to hash table
+ *
+ * Run the same trace of adds, searches and deletes against every engine,
+ * and report operations per second and memory
+ *
+ * The trace is read from the file given as argument, one operation per line:
+ * "a <key>" to add, "s <key>" to search and "d <key>" to delete.
+ * Without file, the trace is of sessions: each new session is added, searched
+ * twice among the live ones, and the oldest one is deleted
+*/
+
+#define SESSIONS (1 << 18)
+#define STEPS (1 << 20)
+#define SAMPLE (1 << 16)
+
+
+/**
+ * Operation of the trace
+*/
+typedef struct {
+  char op;
+  int key;
+} Operation;
+
+
+/**
+ * Scramble the key i (murmur3 finalizer, so different i give different keys)
+*/
+int scramble(int i) {
+  return (int) hash_mix((unsigned) i);
+}
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Read the trace of the file, return it and save its length on n (NULL if it cant be read)
+*/
+Operation* trace_read(char* path, int* n) {
+
+  FILE* file = fopen(path, "r");
+  if (not file) return NULL;
+
+  int capacity = 1024;
+  Operation* trace = malloc(sizeof(Operation) * capacity);
+
+  *n = 0;
+  char op;
+  int key;
+  while (fscanf(file, " %c %i", &op, &key) == 2) {
+    if (*n == capacity) {
+      capacity *= 2;
+      trace = realloc(trace, sizeof(Operation) * capacity);
+    }
+    trace[*n].op = op;
+    trace[(*n)++].key = key;
+  }
+
+  fclose(file);
+  return trace;
+}
+
+
+/**
+ * Make the trace of sessions, return it and save its length on n
+*/
+Operation* trace_sessions(int* n) {
+
+  Operation* trace = malloc(sizeof(Operation) * (SESSIONS + STEPS * 4));
+  unsigned random = 2463534242u;
+
+  *n = 0;
+  for (int i = 0; i < SESSIONS; i++) trace[(*n)++] = (Operation) {'a', scramble(i)};
+
+  for (int i = SESSIONS; i < SESSIONS + STEPS; i++) {
+
+    trace[(*n)++] = (Operation) {'a', scramble(i)};
+
+    for (int j = 0; j < 2; j++) {
+      random ^= random << 13;
+      random ^= random >> 17;
+      random ^= random << 5;
+      trace[(*n)++] = (Operation) {'s', scramble(i - random % SESSIONS)};
+    }
+
+    trace[(*n)++] = (Operation) {'d', scramble(i - SESSIONS)};
+  }
+
+  return trace;
+}
+
+
+/**
+ * Bytes asked to malloc and not freed yet (in the heap and in mmap)
+*/
+size_t heap_used() {
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+}
+
+
+/**
+ * Run the trace on a table of the engine, save the operations per second,
+ * the peak of memory (sampled between batches of operations) and the memory at the end (in bytes),
+ * and return the amount of searches found
+*/
+int bench_trace(HashEngine engine, Operation* trace, int n, double* ops, size_t* peak, size_t* end) {
+
+  size_t base = heap_used();
+
+  Table table = table_create(engine, 16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  int found = 0;
+  *peak = 0;
+  clock_t time = 0;
+
+  for (int first = 0; first < n; first += SAMPLE) {
+
+    int last = first + SAMPLE < n ? first + SAMPLE : n;
+
+    clock_t start = clock();
+    for (int i = first; i < last; i++) {
+      if (trace[i].op == 'a') table_add(table, &trace[i].key);
+      else if (trace[i].op == 's') found += table_search(table, &trace[i].key) != NULL;
+      else if (trace[i].op == 'd') table_delete(table, &trace[i].key);
+    }
+    time += clock() - start;
+
+    // Sample the memory (out of the time)
+    size_t used = heap_used() - base;
+    if (used > *peak) *peak = used;
+  }
+
+  *ops = n / ((double) time / CLOCKS_PER_SEC);
+  *end = heap_used() - base;
+
+  table_destroy(table);
+
+  return found;
+}
+
+
+int main(int argc, char* *argv) {
+
+  int n;
+  Operation* trace = argc > 1 ? trace_read(argv[1], &n) : trace_sessions(&n);
+
+  if (not trace) {
+    printf("Cant read the trace %s\n", argv[1]);
+    return 1;
+  }
+
+  printf("Trace of %i operations\n", n);
+  printf("%16s %14s %12s %12s %10s\n", "engine", "ops (Mops/s)", "peak (MB)", "end (MB)", "found");
+
+  for (HashEngine engine = 0; engine < ENGINES; engine++) {
+
+    double ops;
+    size_t peak, end;
+    int found = bench_trace(engine, trace, n, &ops, &peak, &end);
+
+    printf("%16s %14.2f %12.2f %12.2f %10i\n", table_engine_name(engine), ops / 1e6, peak / 1048576.0,
+      end / 1048576.0, found);
+  }
+
+  free(trace);
+  return 0;
+}
\ No newline at end of file
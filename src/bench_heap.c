@@ -0,0 +1,110 @@
+#include "heap.h"
+#include "heap_key.h"
+#include "int.h"
+#include <time.h>
+
+
+/**
+ * Benchmark to heap
+ *
+ * Push and pop cost of heaps of 2, 4 and 8 childs per father, from 10^3 to 10^7 keys,
+ * and of the heap of keys (the keys in the array, arity KHEAP_ARITY)
+*/
+
+
+/**
+ * Scramble the key i (odd multiplier, so it is a permutation of 0..2^32)
+*/
+int scramble(int i) {
+  return (int) ((unsigned) i * 2654435761u);
+}
+
+
+/**
+ * Push n keys in an empty min heap of the given arity and then pop all of them,
+ * save the seconds spent on each, and return false if they dont come out in order
+*/
+int bench_heap(int arity, int n, double* push, double* pop) {
+
+  BHeap heap = bheap_create_arity(n, arity, MIN, copy_int, destroy_int, compare_int, visit_int);
+
+  clock_t start = clock();
+  for (int i = 0; i < n; i++) {
+    int key = scramble(i);
+    bheap_add(heap, &key);
+  }
+  *push = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  int sorted = true, previous = 0;
+
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    int key = *(int*) bheap_top(heap);
+    if (i > 0 and key < previous) sorted = false;
+    previous = key;
+    bheap_pop(heap);
+  }
+  *pop = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  bheap_destroy(heap);
+
+  return sorted;
+}
+
+
+/**
+ * Same as bench_heap, on a min heap of keys (the payloads are the keys)
+*/
+int bench_kheap(int n, double* push, double* pop) {
+
+  KHeap heap = kheap_create(n, MIN);
+
+  clock_t start = clock();
+  for (int i = 0; i < n; i++) {
+    unsigned key = (unsigned) scramble(i);
+    kheap_add(heap, key, NULL);
+  }
+  *push = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  int sorted = true;
+  uint64_t previous = 0;
+
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    uint64_t key = kheap_top_key(heap);
+    if (key < previous) sorted = false;
+    previous = key;
+    kheap_pop(heap);
+  }
+  *pop = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  kheap_destroy(heap);
+
+  return sorted;
+}
+
+
+int main() {
+
+  int arities[] = {2, 4, 8};
+
+  printf("%10s %6s %12s %12s %8s\n", "keys", "arity", "push ns/key", "pop ns/key", "sorted");
+
+  double push, pop;
+  int sorted;
+
+  for (int n = 1000; n <= 10000000; n *= 10) {
+    for (int i = 0; i < 3; i++) {
+
+      sorted = bench_heap(arities[i], n, &push, &pop);
+
+      printf("%10i %6i %12.1f %12.1f %8s\n", n, arities[i], push * 1e9 / n, pop * 1e9 / n, sorted ? "yes" : "no");
+    }
+
+    sorted = bench_kheap(n, &push, &pop);
+
+    printf("%10i %6s %12.1f %12.1f %8s\n", n, "keys", push * 1e9 / n, pop * 1e9 / n, sorted ? "yes" : "no");
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "hash_chaining.h"
+#include "mix.h"
 
 
 /**
@@ -19,12 +20,13 @@ HList hlist_create() { return NULL; }
 
 
 /**
- * Add data to the begin of the list
+ * Add data with its hash to the begin of the list
 */
-HList hlist_add(HList list, void* data, FunctionCopy copy) {
+HList hlist_add(HList list, void* data, unsigned hash, FunctionCopy copy) {
 
     HList newNode = malloc(sizeof(struct _HNode));
     newNode->data = copy(data);
+    newNode->hash = hash;
     newNode->next = list;
 
     return newNode;
@@ -58,9 +60,9 @@ void hlist_print(HList list, FunctionVisit visit) {
 
 
 /**
- * Delete data at some given index in the list
+ * Take data at some given index out of the list (without destroy it), saving it on taken
 */
-HList hlist_delete(HList list, int index, FunctionDestroy destroy) {
+HList hlist_take(HList list, int index, void* *taken) {
 
     if (not list) return NULL;
 
@@ -71,7 +73,7 @@ HList hlist_delete(HList list, int index, FunctionDestroy destroy) {
     if (index == 0) {
 
         list = list->next;
-        destroy(nodeDelete->data);
+        *taken = nodeDelete->data;
         free(nodeDelete);
 
         return list;
@@ -87,7 +89,7 @@ HList hlist_delete(HList list, int index, FunctionDestroy destroy) {
         nodeDelete = node->next;
         node->next = node->next->next; // Relink
         
-        destroy(nodeDelete->data);
+        *taken = nodeDelete->data;
         free(nodeDelete);
     }
 
@@ -97,14 +99,15 @@ HList hlist_delete(HList list, int index, FunctionDestroy destroy) {
 
 /**
  * Search data in the list, return the index of data if its on it, -1 otherwise
+ * (only compare data of the nodes with the same hash)
 */
-int hlist_search_index(HList list, void* data, FunctionCompare compare) {
+int hlist_search_index(HList list, void* data, unsigned hash, FunctionCompare compare) {
 
     if (not list) return -1;
 
-    if (compare(list->data, data) == 0) return 0;
+    if (list->hash == hash and compare(list->data, data) == 0) return 0;
     
-    int index = hlist_search_index(list->next, data, compare);
+    int index = hlist_search_index(list->next, data, hash, compare);
 
     if (index == -1) return -1;
     else return 1 + index;
@@ -114,41 +117,74 @@ int hlist_search_index(HList list, void* data, FunctionCompare compare) {
 
 /**
  * Search data in the list, return data (pointer on list) if its in, NULL otherwise
+ * (only compare data of the nodes with the same hash)
 */
-void* hlist_search_data(HList list, void* data, FunctionCompare compare) {
+void* hlist_search_data(HList list, void* data, unsigned hash, FunctionCompare compare) {
 
     if (not list) return NULL;
 
-    if (compare(list->data, data) == 0) return list->data;
+    if (list->hash == hash and compare(list->data, data) == 0) return list->data;
     
-    else return hlist_search_data(list->next, data, compare);
+    else return hlist_search_data(list->next, data, hash, compare);
 }
 
 
 /**
  * Search data in the list, return the node of data if its on it, NULL otherwise
+ * (only compare data of the nodes with the same hash)
 */
-HList hlist_search_node(HList list, void* data, FunctionCompare compare) {
+HList hlist_search_node(HList list, void* data, unsigned hash, FunctionCompare compare) {
 
     if (not list) return NULL;
 
-    if (compare(list->data, data) == 0) return list;
+    if (list->hash == hash and compare(list->data, data) == 0) return list;
     
-    else return hlist_search_node(list->next, data, compare);
+    else return hlist_search_node(list->next, data, hash, compare);
+}
+
+
+/**
+ * Return the index of the given hash in an array of the given capacity
+ * (a mask of the mixed hash if the capacity is a power of two, the modulo otherwise)
+*/
+int chaining_index(ChainingHash table, unsigned hash, int capacity) {
+
+    if (table->powerOfTwo) return hash_mix(hash) & (capacity - 1);
+
+    return hash % capacity;
+}
+
+
+/**
+ * Round up the capacity to a power of two
+*/
+int chaining_round_capacity(int capacity) {
+
+    int rounded = 1;
+    while (rounded < capacity) rounded *= 2;
+
+    return rounded;
 }
 
 
 /**
  * Create an empty hash table
 */
-Hash hash_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash) {
+ChainingHash chaining_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash) {
 
-    Hash newTable = malloc(sizeof(struct _Hash));
+    ChainingHash newTable = malloc(sizeof(struct _ChainingHash));
 
     newTable->capacity = capacity;
     newTable->stuffed = 0;
+
+    newTable->oldArray = NULL;
+    newTable->oldCapacity = 0;
+    newTable->rehashIdx = 0;
+    newTable->rehashStep = 0;
+
+    newTable->powerOfTwo = false;
     
-    newTable->array = malloc(sizeof(Cell) * newTable->capacity);
+    newTable->array = malloc(sizeof(HCell) * newTable->capacity);
 
     for (int i = 0; i < newTable->capacity; i++) {
 
@@ -168,7 +204,7 @@ Hash hash_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, Funct
 /**
  * Destroy the hash table
 */
-void hash_destroy(Hash table) {
+void chaining_destroy(ChainingHash table) {
 
     if (not table) return;
 
@@ -185,6 +221,16 @@ void hash_destroy(Hash table) {
     
     // Free the array
     free(table->array);
+
+    // If it was rehashing, destroy the cells not moved yet and free the old array
+    if (table->oldArray exist) {
+
+        for (int i = table->rehashIdx; i < table->oldCapacity; i++) {
+
+            hlist_destroy(table->oldArray[i], table->destroy);
+        }
+        free(table->oldArray);
+    }
     
     // Free the table
     free(table);
@@ -194,142 +240,322 @@ void hash_destroy(Hash table) {
 /**
  * Return the capacity of the hash table
  */
-int hash_capacity(Hash table) { return table->capacity; }
+int chaining_capacity(ChainingHash table) { return table->capacity; }
 
 
 /**
  * Return the amount of stuffed cells in the hash table
  */
-int hash_stuffed(Hash table) { return table->stuffed; }
+int chaining_stuffed(ChainingHash table) { return table->stuffed; }
+
+
+/**
+ * Move the given amount of cells from the old array to the new one, relinking their nodes
+ * Free the old array when all its cells were moved
+*/
+void chaining_rehash_move(ChainingHash table, int cells) {
+
+    for (; cells > 0 and table->oldArray exist; cells--) {
+
+        // Move each node of the cell to its cell in the new array
+        for (HList node = table->oldArray[table->rehashIdx]; node exist; ) {
+
+            HList next = node->next;
+            int idx = chaining_index(table, node->hash, table->capacity);
+
+            node->next = table->array[idx];
+            table->array[idx] = node;
+
+            node = next;
+        }
+        table->oldArray[table->rehashIdx++] = NULL;
+
+        // If all the cells were moved
+        if (table->rehashIdx == table->oldCapacity) {
+
+            free(table->oldArray);
+            table->oldArray = NULL;
+        }
+    }
+}
+
+
+/**
+ * Start to rehash at the given capacity
+ * (the cells of the old array are moved later by chaining_rehash_move)
+*/
+void chaining_rehash_start(ChainingHash table, int capacity) {
+
+    table->oldArray = table->array;
+    table->oldCapacity = table->capacity;
+    table->rehashIdx = 0;
+
+    // calloc gives all the lists empty without touching each cell,
+    // so starting costs the same at any capacity
+    table->capacity = capacity;
+    table->array = calloc(table->capacity, sizeof(HCell));
+}
+
+
+/**
+ * Return the cell of the hash table where data of the given hash goes
+ * (while rehashing, it may be a cell of the old array not moved yet)
+*/
+HCell* chaining_cell(ChainingHash table, unsigned hash) {
+
+    // If its rehashing and the cell of data wasnt moved yet
+    if (table->oldArray exist) {
+
+        int oldIdx = chaining_index(table, hash, table->oldCapacity);
+        if (oldIdx >= table->rehashIdx) return &table->oldArray[oldIdx];
+    }
+
+    return &table->array[chaining_index(table, hash, table->capacity)];
+}
 
 
 /**
  * Search given data in the hash table
 */
-void* hash_search(Hash table, void* data) {
+void* chaining_search(ChainingHash table, void* data) {
 
     if (not table) return NULL;
 
-    // Calculate key of data
-    int idx = table->hash(data) % table->capacity;
+    // Keep rehashing
+    chaining_rehash_move(table, table->rehashStep);
 
     // Search data in the cell of the key
-    return hlist_search_data(table->array[idx], data, table->compare);
+    unsigned hash = table->hash(data);
+    return hlist_search_data(*chaining_cell(table, hash), data, hash, table->compare);
 }
 
 
 /**
- * Add given data to the hash table
+ * Search the given amount of keys in the hash table, saving on out the data of each one (or NULL)
+ *
+ * The keys go in batches of CHAINING_SEARCH_BATCH: first their hashes are calculated and their
+ * cells prefetched, then the first node of each list, then the data of the first nodes
+ * with the same hash, and at last each key is searched, so the cache misses of the batch overlap
 */
-void hash_add(Hash table, void* data) {
+void chaining_search_batch(ChainingHash table, void* *keys, int n, void* *out) {
+
+    if (not table) return;
+
+    // Keep rehashing
+    chaining_rehash_move(table, table->rehashStep);
+
+    unsigned hashes[CHAINING_SEARCH_BATCH];
+    HCell* cells[CHAINING_SEARCH_BATCH];
+
+    for (int first = 0; first < n; first += CHAINING_SEARCH_BATCH) {
+
+        int size = n - first < CHAINING_SEARCH_BATCH ? n - first : CHAINING_SEARCH_BATCH;
+
+        // Hash each key and prefetch its cell
+        for (int i = 0; i < size; i++) {
+
+            hashes[i] = table->hash(keys[first + i]);
+            cells[i] = chaining_cell(table, hashes[i]);
+            __builtin_prefetch(cells[i]);
+        }
+
+        // Prefetch the first node of each list
+        for (int i = 0; i < size; i++) {
+
+            if (*cells[i] exist) __builtin_prefetch(*cells[i]);
+        }
+
+        // Prefetch the data of the first nodes that may have the key
+        for (int i = 0; i < size; i++) {
+
+            if (*cells[i] exist and (*cells[i])->hash == hashes[i]) __builtin_prefetch((*cells[i])->data);
+        }
+
+        // Search each key (mostly in cache now)
+        for (int i = 0; i < size; i++) {
+
+            out[first + i] = hlist_search_data(*cells[i], keys[first + i], hashes[i], table->compare);
+        }
+    }
+}
+
+
+/**
+ * Auxiliar "copy" function to reserve a slot
+ * (do not copy actually)
+*/
+void* chaining_pointer(void* data) {
+
+    return data;
+}
+
+
+/**
+ * Return the slot of given data in the hash table, and save on found if data was already on it
+ * If data isnt on the table, a slot is added for it with given data (without copy it),
+ * to replace by the caller with data equal to it
+*/
+void* *chaining_slot(ChainingHash table, void* data, int* found) {
+
+    if (not table) return NULL;
+
+    // Keep rehashing
+    chaining_rehash_move(table, table->rehashStep);
 
     // Calculate the charge factor and evaluate if needs to rehash
-    if ((float) table->stuffed / (float) table->capacity > OVERLOAD_CHARGE_FACTOR) {
+    if (not table->oldArray and (float) table->stuffed / (float) table->capacity > CHAINING_OVERLOAD_CHARGE_FACTOR) {
+
+        // Rehash incrementally
+        if (table->rehashStep > 0)
+            chaining_rehash_start(table, table->capacity * 2);
 
-        // Rehash
-        hash_rehash(table);
+        // Rehash at once
+        else
+            chaining_rehash(table);
     }
 
-    // Calculate key of data
-    int idx = table->hash(data) % table->capacity;
+    // HCell of data
+    unsigned hash = table->hash(data);
+    HCell* cell = chaining_cell(table, hash);
     
     // Search the node of data in the hash table
-    Cell searchNode = hlist_search_node(table->array[idx], data, table->compare);
+    HCell searchNode = hlist_search_node(*cell, data, hash, table->compare);
+    *found = searchNode exist;
     
     // If data already exist in the hash table
-    if (searchNode exist) {
+    if (searchNode exist) return &searchNode->data;
 
-        // Destroy to replace without lose memory
-        table->destroy(searchNode->data);
+    // Add a node for data
+    *cell = hlist_add(*cell, data, hash, chaining_pointer);
+    table->stuffed++;
 
-        // Replace data
-        searchNode->data = table->copy(data);
-    }
+    return &(*cell)->data;
+}
 
-    // If data doesnt exist in the hash table
-    else {
 
-        // Add data
-        table->array[idx] = hlist_add(table->array[idx], data, table->copy);
-        table->stuffed++;
-    }
+/**
+ * Add given data to the hash table
+*/
+void chaining_add(ChainingHash table, void* data) {
+
+    if (not table) return;
+
+    int found;
+    void* *slot = chaining_slot(table, data, &found);
+
+    // If data already exist in the hash table, destroy to replace without lose memory
+    if (found) table->destroy(*slot);
+
+    // Add data
+    *slot = table->copy(data);
 }
 
 
 /**
- * Delete given data from the hash table
+ * Take given data out of the hash table (without destroy it)
+ * Return data of the table, or NULL if it isnt on it
 */
-void hash_delete(Hash table, void* data) {
+void* chaining_take(ChainingHash table, void* data) {
 
-    if (not table) return;
+    if (not table) return NULL;
 
-    // Calculate key of data
-    int idx = table->hash(data) % table->capacity;
+    // Keep rehashing
+    chaining_rehash_move(table, table->rehashStep);
 
+    // HCell of data
+    unsigned hash = table->hash(data);
+    HCell* cell = chaining_cell(table, hash);
     
     // Search index of data
-    int searchIndex = hlist_search_index(table->array[idx], data, table->compare);
+    int searchIndex = hlist_search_index(*cell, data, hash, table->compare);
 
-    // If data already exist in the hash table
-    if (searchIndex != -1) {
+    // If data doesnt exist in the hash table
+    if (searchIndex == -1) return NULL;
 
-        // Delete data
-        table->array[idx] = hlist_delete(table->array[idx], searchIndex, table->destroy);
-    }
+    // Take data
+    void* taken;
+    *cell = hlist_take(*cell, searchIndex, &taken);
+    table->stuffed--;
+
+    return taken;
+}
+
+
+/**
+ * Delete given data from the hash table
+*/
+void chaining_delete(ChainingHash table, void* data) {
+
+    if (not table) return;
+
+    void* taken = chaining_take(table, data);
+
+    // If data was in the hash table
+    if (taken exist) table->destroy(taken);
 }
 
 
 /**
  * Resize the hash table at double of its capacity and rehash each of its elements
 */
-void hash_rehash(Hash table) {
+void chaining_rehash(ChainingHash table) {
 
     if (not table) return;
 
-    // Auxiliar array to delete
-    Cell *oldArray = table->array;
+    // If its rehashing incrementally, finish it first
+    chaining_rehash_move(table, table->oldCapacity);
 
-    // Resize the array of the table
-    table->capacity *= 2;
-    table->stuffed = 0;
-    table->array = malloc(sizeof(Cell) * table->capacity);
+    // Resize the array of the table and move all the cells,
+    // relinking the nodes (without copy data or ask memory for them)
+    chaining_rehash_start(table, table->capacity * 2);
+    chaining_rehash_move(table, table->oldCapacity);
+}
 
-    // Initialize the new array
-    for (int i = 0; i < table->capacity; i++) {
 
-        table->array[i] = hlist_create();
-    }
+/**
+ * Rehash incrementally, moving the given amount of cells to the new array
+ * on each search, add and delete, instead of all at once (0 to disable)
+*/
+void chaining_set_incremental(ChainingHash table, int cells) {
 
-    // Rehash each element
-    for(int i = 0; i < table->capacity / 2; i++) {
+    if (not table) return;
 
-        // If there is a list on the cell
-        if (oldArray[i] exist) {
+    // Finish the rehash in course, so the table doesnt wait for steps it wont take
+    chaining_rehash_move(table, table->oldCapacity);
 
-            // Iterate through the list
-            for (HList aux = oldArray[i]; aux exist; aux = aux->next) {
+    table->rehashStep = cells;
+}
 
-                // Rehash
-                hash_add(table, aux->data);
-            }
 
-            // Destroy the list
-            hlist_destroy(oldArray[i], table->destroy);
-        }
-    }
+/**
+ * Index with a mask of the mixed hash, with the capacity rounded up to a power of two,
+ * instead of the modulo of the hash (false to get back to the modulo)
+*/
+void chaining_set_power_of_two(ChainingHash table, int enable) {
+
+    if (not table) return;
+
+    // If its rehashing incrementally, finish it first
+    chaining_rehash_move(table, table->oldCapacity);
 
-    // Free old array
-    free(oldArray);
+    table->powerOfTwo = enable;
+
+    // Move all the cells to their index of the new mode
+    chaining_rehash_start(table, enable ? chaining_round_capacity(table->capacity) : table->capacity);
+    chaining_rehash_move(table, table->oldCapacity);
 }
 
 
 /**
  * Print the hash table
 */
-void hash_print(Hash table) {
+void chaining_print(ChainingHash table) {
 
     if (not table) return;
 
+    // If its rehashing incrementally, finish it so all the elements are in the array
+    chaining_rehash_move(table, table->oldCapacity);
+
     // Iterate through the hash table
     for (int i = 0; i < table->capacity; i++) {
 
@@ -20,6 +20,7 @@
 typedef struct _HNode {
 
     void* data;
+    unsigned hash; /* Hash of data, to rehash and compare only data with the same hash */
     struct _HNode *next;
 
 } *HList;
@@ -28,18 +29,25 @@ typedef struct _HNode {
 /**
  * Struct of each cell of the hash table
 */
-typedef HList Cell;
+typedef HList HCell;
 
 
 /**
  * Struct of the hash table
 */
-typedef struct _Hash {
+typedef struct _ChainingHash {
 
-    Cell *array;
+    HCell *array;
 
     int capacity;
     int stuffed;
+
+    HCell *oldArray; /* Array being rehashed, NULL if its not rehashing */
+    int oldCapacity;
+    int rehashIdx; /* Next cell of the old array to move */
+    int rehashStep; /* Cells moved per operation while rehashing, 0 to rehash at once */
+
+    int powerOfTwo; /* Capacity is a power of two, index with a mask of the mixed hash */
     
     FunctionCopy copy;
     FunctionCompare compare;
@@ -47,67 +55,109 @@ typedef struct _Hash {
     FunctionVisit visit;
     FunctionHash hash;
 
-} *Hash;
+} *ChainingHash;
 
 
 /**
  * Overload charge factor to decide when to rehash
 */
-#define OVERLOAD_CHARGE_FACTOR 0.75
+#define CHAINING_OVERLOAD_CHARGE_FACTOR 0.75
+
+
+/**
+ * Amount of keys searched together by chaining_search_batch
+*/
+#define CHAINING_SEARCH_BATCH 16
 
 
 /**
  * Create an empty hash table
 */
-Hash hash_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash);
+ChainingHash chaining_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash);
 
 
 /**
  * Destroy the hash table
 */
-void hash_destroy(Hash table);
+void chaining_destroy(ChainingHash table);
 
 
 /**
  * Return the capacity of the hash table
  */
-int hash_capacity(Hash table);
+int chaining_capacity(ChainingHash table);
 
 
 /**
  * Return the amount of stuffed cells in the hash table
  */
-int hash_stuffed(Hash table);
+int chaining_stuffed(ChainingHash table);
 
 
 /**
  * Search given data in the hash table
 */
-void* hash_search(Hash table, void* data);
+void* chaining_search(ChainingHash table, void* data);
+
+
+/**
+ * Search the given amount of keys in the hash table, saving on out the data of each one (or NULL)
+ * The keys are hashed and their cells prefetched by batches, so the cache misses overlap
+*/
+void chaining_search_batch(ChainingHash table, void* *keys, int n, void* *out);
 
 
 /**
  * Add given data to the hash table
 */
-void hash_add(Hash table, void* data);
+void chaining_add(ChainingHash table, void* data);
+
+
+/**
+ * Return the slot of given data in the hash table, and save on found if data was already on it
+ * If data isnt on the table, a slot is added for it with given data (without copy it),
+ * to replace by the caller with data equal to it
+*/
+void* *chaining_slot(ChainingHash table, void* data, int* found);
+
+
+/**
+ * Take given data out of the hash table (without destroy it)
+ * Return data of the table, or NULL if it isnt on it
+*/
+void* chaining_take(ChainingHash table, void* data);
 
 
 /**
  * Delete given data from the hash table
 */
-void hash_delete(Hash table, void* data);
+void chaining_delete(ChainingHash table, void* data);
 
 
 /**
  * Resize the hash table at double of its capacity and rehash each of its elements
 */
-void hash_rehash(Hash table);
+void chaining_rehash(ChainingHash table);
+
+
+/**
+ * Rehash incrementally, moving the given amount of cells to the new array
+ * on each search, add and delete, instead of all at once (0 to disable)
+*/
+void chaining_set_incremental(ChainingHash table, int cells);
+
+
+/**
+ * Index with a mask of the mixed hash, with the capacity rounded up to a power of two,
+ * instead of the modulo of the hash (false to get back to the modulo)
+*/
+void chaining_set_power_of_two(ChainingHash table, int enable);
 
 
 /**
  * Print the hash table
 */
-void hash_print(Hash);
+void chaining_print(ChainingHash);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,356 @@
+#include "hash_concurrent.h"
+#include "mix.h"
+
+
+/**
+ * Concurrent hash table
+ *
+ * Open hashing: separate chaining with striped locks
+*/
+
+
+/**
+ * Return the stripe of the given hash
+ * (the low bits of the index, that dont change when the capacity doubles)
+*/
+Stripe* chash_stripe(CHash table, unsigned hash) {
+
+    return &table->stripes[hash_mix(hash) & (CHASH_STRIPES - 1)];
+}
+
+
+/**
+ * Return the cell of the given hash (the lock of its stripe must be taken)
+*/
+CList* chash_cell(CHash table, unsigned hash) {
+
+    return &table->array[hash_mix(hash) & (table->capacity - 1)];
+}
+
+
+/**
+ * Search data in the list, return the node of data if its on it, NULL otherwise
+ * (only compare data of the nodes with the same hash)
+*/
+CList clist_search(CList list, void* data, unsigned hash, FunctionCompare compare) {
+
+    for (; list exist; list = list->next) {
+
+        if (list->hash == hash and compare(list->data, data) == 0) return list;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Create an empty concurrent hash table
+ * The capacity is rounded up to a power of two
+*/
+CHash chash_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash) {
+
+    // Ask memory for the hash table, aligned as its stripes so each one has its own cache line
+    CHash newTable = aligned_alloc(_Alignof(struct _CHash), sizeof(struct _CHash));
+
+    // Round up the capacity to a power of two, at least the amount of stripes
+    newTable->capacity = CHASH_STRIPES;
+    while (newTable->capacity < capacity) newTable->capacity *= 2;
+
+    newTable->array = calloc(newTable->capacity, sizeof(CList));
+
+    for (int i = 0; i < CHASH_STRIPES; i++) {
+
+        pthread_rwlock_init(&newTable->stripes[i].lock, NULL);
+        newTable->stripes[i].stuffed = 0;
+    }
+
+    newTable->copy = copy;
+    newTable->destroy = destroy;
+    newTable->compare = compare;
+    newTable->visit = visit;
+    newTable->hash = hash;
+
+    return newTable;
+}
+
+
+/**
+ * Destroy the concurrent hash table (no other thread may use it)
+*/
+void chash_destroy(CHash table) {
+
+    if (not table) return;
+
+    // Iterate through the hash table
+    for (int i = 0; i < table->capacity; i++) {
+
+        // Destroy the list of the cell
+        for (CList node = table->array[i]; node exist; ) {
+
+            CList next = node->next;
+
+            table->destroy(node->data);
+            free(node);
+
+            node = next;
+        }
+    }
+
+    for (int i = 0; i < CHASH_STRIPES; i++) {
+
+        pthread_rwlock_destroy(&table->stripes[i].lock);
+    }
+
+    free(table->array);
+    free(table);
+}
+
+
+/**
+ * Return the capacity of the concurrent hash table
+ */
+int chash_capacity(CHash table) {
+
+    // Take some lock, so its not resizing
+    pthread_rwlock_rdlock(&table->stripes[0].lock);
+    int capacity = table->capacity;
+    pthread_rwlock_unlock(&table->stripes[0].lock);
+
+    return capacity;
+}
+
+
+/**
+ * Return the amount of stuffed cells in the concurrent hash table
+ */
+int chash_stuffed(CHash table) {
+
+    int stuffed = 0;
+
+    for (int i = 0; i < CHASH_STRIPES; i++) {
+
+        pthread_rwlock_rdlock(&table->stripes[i].lock);
+        stuffed += table->stripes[i].stuffed;
+        pthread_rwlock_unlock(&table->stripes[i].lock);
+    }
+
+    return stuffed;
+}
+
+
+/**
+ * Return true if given data is in the concurrent hash table, false otherwise
+*/
+int chash_contains(CHash table, void* data) {
+
+    if (not table) return false;
+
+    unsigned hash = table->hash(data);
+    Stripe* stripe = chash_stripe(table, hash);
+
+    pthread_rwlock_rdlock(&stripe->lock);
+    int found = clist_search(*chash_cell(table, hash), data, hash, table->compare) exist;
+    pthread_rwlock_unlock(&stripe->lock);
+
+    return found;
+}
+
+
+/**
+ * Search given data in the concurrent hash table
+ * Return a copy of data of the table (to destroy by the caller), or NULL if it isnt on it
+ * (data of the table may be deleted by other thread at any moment, so it isnt returned)
+*/
+void* chash_search(CHash table, void* data) {
+
+    if (not table) return NULL;
+
+    unsigned hash = table->hash(data);
+    Stripe* stripe = chash_stripe(table, hash);
+
+    pthread_rwlock_rdlock(&stripe->lock);
+    CList node = clist_search(*chash_cell(table, hash), data, hash, table->compare);
+    void* copy = node exist ? table->copy(node->data) : NULL;
+    pthread_rwlock_unlock(&stripe->lock);
+
+    return copy;
+}
+
+
+/**
+ * Resize the concurrent hash table at double of the given capacity (all the locks must be taken)
+ * If the capacity isnt the given one, other thread already resized it, so it does nothing
+*/
+void chash_grow(CHash table, int capacity) {
+
+    if (table->capacity != capacity) return;
+
+    CList *oldArray = table->array;
+    int oldCapacity = table->capacity;
+
+    table->capacity *= 2;
+    table->array = calloc(table->capacity, sizeof(CList));
+
+    // Move each node to its cell in the new array, relinking it
+    for (int i = 0; i < oldCapacity; i++) {
+
+        for (CList node = oldArray[i]; node exist; ) {
+
+            CList next = node->next;
+            CList* cell = chash_cell(table, node->hash);
+
+            node->next = *cell;
+            *cell = node;
+
+            node = next;
+        }
+    }
+
+    free(oldArray);
+}
+
+
+/**
+ * Take all the locks of the concurrent hash table (always in the same order)
+ * and resize it at double of the given capacity
+*/
+void chash_grow_locked(CHash table, int capacity) {
+
+    for (int i = 0; i < CHASH_STRIPES; i++) pthread_rwlock_wrlock(&table->stripes[i].lock);
+
+    chash_grow(table, capacity);
+
+    for (int i = CHASH_STRIPES - 1; i >= 0; i--) pthread_rwlock_unlock(&table->stripes[i].lock);
+}
+
+
+/**
+ * Add given data to the concurrent hash table
+*/
+void chash_add(CHash table, void* data) {
+
+    if (not table) return;
+
+    unsigned hash = table->hash(data);
+    Stripe* stripe = chash_stripe(table, hash);
+
+    pthread_rwlock_wrlock(&stripe->lock);
+
+    CList* cell = chash_cell(table, hash);
+    CList searchNode = clist_search(*cell, data, hash, table->compare);
+
+    // If data already exist in the hash table
+    if (searchNode exist) {
+
+        // Destroy to replace without lose memory
+        table->destroy(searchNode->data);
+
+        // Replace data
+        searchNode->data = table->copy(data);
+    }
+
+    // If data doesnt exist in the hash table
+    else {
+
+        // Add data
+        CList newNode = malloc(sizeof(struct _CNode));
+        newNode->data = table->copy(data);
+        newNode->hash = hash;
+        newNode->next = *cell;
+
+        *cell = newNode;
+        stripe->stuffed++;
+    }
+
+    // Calculate the charge factor of the stripe and evaluate if needs to resize
+    int capacity = table->capacity;
+    int overload = stripe->stuffed > CHASH_OVERLOAD_CHARGE_FACTOR * capacity / CHASH_STRIPES;
+
+    pthread_rwlock_unlock(&stripe->lock);
+
+    // Resize (out of the lock of the stripe, since it takes all of them)
+    if (overload) chash_grow_locked(table, capacity);
+}
+
+
+/**
+ * Delete given data from the concurrent hash table
+*/
+void chash_delete(CHash table, void* data) {
+
+    if (not table) return;
+
+    unsigned hash = table->hash(data);
+    Stripe* stripe = chash_stripe(table, hash);
+
+    pthread_rwlock_wrlock(&stripe->lock);
+
+    // Search the link to the node of data
+    for (CList* link = chash_cell(table, hash); *link exist; link = &(*link)->next) {
+
+        // If data found
+        if ((*link)->hash == hash and table->compare((*link)->data, data) == 0) {
+
+            CList node = *link;
+            *link = node->next; // Relink
+
+            table->destroy(node->data);
+            free(node);
+            stripe->stuffed--;
+            break;
+        }
+    }
+
+    pthread_rwlock_unlock(&stripe->lock);
+}
+
+
+/**
+ * Resize the concurrent hash table at double of its capacity and rehash each of its elements
+*/
+void chash_rehash(CHash table) {
+
+    if (not table) return;
+
+    chash_grow_locked(table, chash_capacity(table));
+}
+
+
+/**
+ * Print the concurrent hash table
+*/
+void chash_print(CHash table) {
+
+    if (not table) return;
+
+    for (int i = 0; i < CHASH_STRIPES; i++) pthread_rwlock_rdlock(&table->stripes[i].lock);
+
+    // Iterate through the hash table
+    for (int i = 0; i < table->capacity; i++) {
+
+        // At each cell
+        printf("[%i]: ", i);
+
+        // If there is a list on the cell
+        if (table->array[i] exist) {
+
+            // Travel through the list
+            for (CList aux = table->array[i]; aux exist; aux = aux->next) {
+
+                // Print data
+                table->visit(aux->data);
+                printf(" ");
+            }
+        }
+
+        // If doesnt exist
+        else {
+
+            printf("NULL");
+        }
+
+        puts("");
+    }
+
+    for (int i = CHASH_STRIPES - 1; i >= 0; i--) pthread_rwlock_unlock(&table->stripes[i].lock);
+}
\ No newline at end of file
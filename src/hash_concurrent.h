@@ -0,0 +1,142 @@
+#ifndef __HASH_CONCURRENT_H__
+#define __HASH_CONCURRENT_H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "void.h"
+#include "sugar.h"
+
+
+/**
+ * Concurrent hash table
+ *
+ * Open hashing: separate chaining with striped locks
+ *
+ * The cells are split in CHASH_STRIPES stripes, each one with a read/write lock.
+ * A search takes the lock of the stripe of data for reading, and an add or a
+ * delete takes it for writing, so threads on different stripes dont wait each other.
+ * The capacity is a power of two (at least CHASH_STRIPES) and the index of data
+ * is a mask of its mixed hash, so when the capacity doubles data keeps its stripe.
+ * Resizing takes all the locks.
+*/
+
+
+/**
+ * Amount of stripes (a power of two)
+*/
+#define CHASH_STRIPES 64
+
+
+/**
+ * Built in linked list
+*/
+typedef struct _CNode {
+
+    void* data;
+    unsigned hash; /* Hash of data, to rehash and compare only data with the same hash */
+    struct _CNode *next;
+
+} *CList;
+
+
+/**
+ * Struct of each stripe (on its own cache line, so the locks dont share lines)
+*/
+typedef struct _Stripe {
+
+    pthread_rwlock_t lock;
+    int stuffed; /* Elements in the cells of the stripe */
+
+} __attribute__((aligned(64))) Stripe;
+
+
+/**
+ * Struct of the concurrent hash table
+*/
+typedef struct _CHash {
+
+    CList *array;
+    int capacity; /* Always a power of two, at least CHASH_STRIPES */
+
+    Stripe stripes[CHASH_STRIPES];
+
+    FunctionCopy copy;
+    FunctionDestroy destroy;
+    FunctionCompare compare;
+    FunctionVisit visit;
+    FunctionHash hash;
+
+} *CHash;
+
+
+/**
+ * Overload charge factor to decide when to resize
+*/
+#define CHASH_OVERLOAD_CHARGE_FACTOR 0.75
+
+
+/**
+ * Create an empty concurrent hash table
+ * The capacity is rounded up to a power of two
+*/
+CHash chash_create(int, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit, FunctionHash);
+
+
+/**
+ * Destroy the concurrent hash table (no other thread may use it)
+*/
+void chash_destroy(CHash);
+
+
+/**
+ * Return the capacity of the concurrent hash table
+ */
+int chash_capacity(CHash);
+
+
+/**
+ * Return the amount of stuffed cells in the concurrent hash table
+ */
+int chash_stuffed(CHash);
+
+
+/**
+ * Return true if given data is in the concurrent hash table, false otherwise
+*/
+int chash_contains(CHash, void*);
+
+
+/**
+ * Search given data in the concurrent hash table
+ * Return a copy of data of the table (to destroy by the caller), or NULL if it isnt on it
+ * (data of the table may be deleted by other thread at any moment, so it isnt returned)
+*/
+void* chash_search(CHash, void*);
+
+
+/**
+ * Add given data to the concurrent hash table
+*/
+void chash_add(CHash, void*);
+
+
+/**
+ * Delete given data from the concurrent hash table
+*/
+void chash_delete(CHash, void*);
+
+
+/**
+ * Resize the concurrent hash table at double of its capacity and rehash each of its elements
+*/
+void chash_rehash(CHash);
+
+
+/**
+ * Print the concurrent hash table
+*/
+void chash_print(CHash);
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,488 @@
+#include "hash_cuckoo.h"
+#include "mix.h"
+#include <string.h>
+
+
+/**
+ * Hash table
+ *
+ * Cuckoo hashing: bucketized (4-way), with a stash
+*/
+
+
+/**
+ * Next random number (xorshift)
+*/
+unsigned cuckoo_random(CuckooHash table) {
+
+    table->random ^= table->random << 13;
+    table->random ^= table->random >> 17;
+    table->random ^= table->random << 5;
+
+    return table->random;
+}
+
+
+/**
+ * Return the first (which = 0) or the second (which = 1) bucket of the given hash
+*/
+int cuckoo_bucket(CuckooHash table, unsigned hash, int which) {
+
+    return hash_mix(hash ^ table->seeds[which]) & (table->capacity - 1);
+}
+
+
+/**
+ * Return the index of the slot of given data in the bucket, or -1 if it isnt on it
+*/
+int cuckoo_slot(CuckooHash table, Bucket* bucket, void* data, unsigned hash) {
+
+    for (int i = 0; i < CUCKOO_WAYS; i++) {
+
+        if (bucket->data[i] exist and bucket->hashes[i] == hash and table->compare(bucket->data[i], data) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+
+/**
+ * Put data in a free slot of the bucket, return false if there is none
+*/
+int cuckoo_put(Bucket* bucket, void* data, unsigned hash) {
+
+    for (int i = 0; i < CUCKOO_WAYS; i++) {
+
+        if (not bucket->data[i]) {
+
+            bucket->data[i] = data;
+            bucket->hashes[i] = hash;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * Ask memory for the given amount of empty buckets
+*/
+Bucket* cuckoo_buckets(int capacity) {
+
+    Bucket* buckets = aligned_alloc(sizeof(Bucket), sizeof(Bucket) * capacity);
+    memset(buckets, 0, sizeof(Bucket) * capacity);
+
+    return buckets;
+}
+
+
+/**
+ * Put data (without copy it) in the stash, asking memory if its full
+*/
+void cuckoo_stash(CuckooHash table, void* data, unsigned hash) {
+
+    if (table->stashed == table->stashCapacity) {
+
+        table->stashCapacity *= 2;
+        table->stash = realloc(table->stash, sizeof(void*) * table->stashCapacity);
+        table->stashHashes = realloc(table->stashHashes, sizeof(unsigned) * table->stashCapacity);
+    }
+
+    table->stash[table->stashed] = data;
+    table->stashHashes[table->stashed] = hash;
+    table->stashed++;
+}
+
+
+/**
+ * Place data (without copy it) in one of its buckets, kicking out other elements if needed,
+ * or in the stash. Return false if there was no room: then the last kicked element is saved
+ * on data and hash, and it isnt in the table
+*/
+int cuckoo_place(CuckooHash table, void* *data, unsigned *hash) {
+
+    table->kicks = 0;
+
+    // If there is a free slot in some of its buckets
+    int first = cuckoo_bucket(table, *hash, 0);
+    if (cuckoo_put(&table->buckets[first], *data, *hash)) return true;
+
+    int current = cuckoo_bucket(table, *hash, 1);
+    if (cuckoo_put(&table->buckets[current], *data, *hash)) return true;
+
+    // Kick out elements till some of them finds a free slot in its other bucket
+    for (; table->kicks < CUCKOO_MAX_KICKS; table->kicks++) {
+
+        // Take the slot of a random element of the current bucket
+        Bucket* bucket = &table->buckets[current];
+        int slot = cuckoo_random(table) % CUCKOO_WAYS;
+
+        void* auxData = bucket->data[slot];
+        unsigned auxHash = bucket->hashes[slot];
+
+        bucket->data[slot] = *data;
+        bucket->hashes[slot] = *hash;
+
+        *data = auxData;
+        *hash = auxHash;
+
+        // Move the kicked element to its other bucket
+        first = cuckoo_bucket(table, *hash, 0);
+        current = first == current ? cuckoo_bucket(table, *hash, 1) : first;
+
+        if (cuckoo_put(&table->buckets[current], *data, *hash)) {
+
+            table->kicks++;
+            return true;
+        }
+    }
+
+    // Put the last kicked element in the stash (any amount of them, if the table spilled)
+    if (table->stashed < CUCKOO_STASH or table->spilled) {
+
+        cuckoo_stash(table, *data, *hash);
+        return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * Rebuild the cuckoo hash table at the given capacity with new hashes, with its elements
+ * and the given extra one (if its not NULL)
+ * If some element doesnt fit, it tries again with other hashes, and doubling the capacity,
+ * till CUCKOO_MAX_REBUILDS tries: then the elements that dont fit go to the stash
+*/
+void cuckoo_rebuild(CuckooHash table, int capacity, void* extra, unsigned extraHash) {
+
+    // Save all the elements
+    int amount = 0;
+    void* *elements = malloc(sizeof(void*) * (table->stuffed + 1));
+    unsigned *hashes = malloc(sizeof(unsigned) * (table->stuffed + 1));
+
+    for (int i = 0; i < table->capacity; i++) {
+
+        for (int j = 0; j < CUCKOO_WAYS; j++) {
+
+            if (table->buckets[i].data[j] exist) {
+
+                elements[amount] = table->buckets[i].data[j];
+                hashes[amount++] = table->buckets[i].hashes[j];
+            }
+        }
+    }
+
+    for (int i = 0; i < table->stashed; i++) {
+
+        elements[amount] = table->stash[i];
+        hashes[amount++] = table->stashHashes[i];
+    }
+
+    if (extra exist) {
+
+        elements[amount] = extra;
+        hashes[amount++] = extraHash;
+    }
+
+    free(table->buckets);
+
+    // Place them with new hashes, till all of them fit
+    for (int tries = 1; ; tries++) {
+
+        table->buckets = cuckoo_buckets(capacity);
+        table->capacity = capacity;
+        table->stashed = 0;
+        table->spilled = false;
+        table->seeds[0] = cuckoo_random(table);
+        table->seeds[1] = cuckoo_random(table);
+
+        int placed = 0;
+        for (; placed < amount; placed++) {
+
+            void* data = elements[placed];
+            unsigned hash = hashes[placed];
+
+            if (not cuckoo_place(table, &data, &hash)) {
+
+                // At the last try, the element left out goes to the stash, that grows
+                if (tries < CUCKOO_MAX_REBUILDS) break;
+
+                cuckoo_stash(table, data, hash);
+                table->spilled = true;
+            }
+        }
+
+        if (placed == amount) break;
+
+        // Some element doesnt fit: try again, doubling the capacity every two tries
+        free(table->buckets);
+        if (tries % 2 == 0) capacity *= 2;
+    }
+
+    table->stuffed = amount;
+    table->kicks = 0;
+
+    free(elements);
+    free(hashes);
+}
+
+
+/**
+ * Create an empty cuckoo hash table with room for the given amount of elements
+ * The amount of buckets is rounded up to a power of two
+*/
+CuckooHash cuckoo_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash) {
+
+    // Ask memory for the hash table
+    CuckooHash newTable = malloc(sizeof(struct _CuckooHash));
+
+    newTable->capacity = 1;
+    while (newTable->capacity * CUCKOO_WAYS < capacity) newTable->capacity *= 2;
+
+    newTable->buckets = cuckoo_buckets(newTable->capacity);
+    newTable->stuffed = 0;
+    newTable->kicks = 0;
+
+    newTable->stash = malloc(sizeof(void*) * CUCKOO_STASH);
+    newTable->stashHashes = malloc(sizeof(unsigned) * CUCKOO_STASH);
+    newTable->stashed = 0;
+    newTable->stashCapacity = CUCKOO_STASH;
+    newTable->spilled = false;
+
+    newTable->random = 2463534242u;
+    newTable->seeds[0] = cuckoo_random(newTable);
+    newTable->seeds[1] = cuckoo_random(newTable);
+
+    newTable->copy = copy;
+    newTable->destroy = destroy;
+    newTable->compare = compare;
+    newTable->visit = visit;
+    newTable->hash = hash;
+
+    return newTable;
+}
+
+
+/**
+ * Destroy the cuckoo hash table
+*/
+void cuckoo_destroy(CuckooHash table) {
+
+    if (not table) return;
+
+    // Iterate through the buckets
+    for (int i = 0; i < table->capacity; i++) {
+
+        for (int j = 0; j < CUCKOO_WAYS; j++) {
+
+            if (table->buckets[i].data[j] exist) table->destroy(table->buckets[i].data[j]);
+        }
+    }
+
+    for (int i = 0; i < table->stashed; i++) table->destroy(table->stash[i]);
+
+    free(table->buckets);
+    free(table->stash);
+    free(table->stashHashes);
+    free(table);
+}
+
+
+/**
+ * Return the capacity of the cuckoo hash table (slots in all the buckets)
+ */
+int cuckoo_capacity(CuckooHash table) { return table->capacity * CUCKOO_WAYS; }
+
+
+/**
+ * Return the amount of stuffed slots in the cuckoo hash table (with the stash)
+ */
+int cuckoo_stuffed(CuckooHash table) { return table->stuffed; }
+
+
+/**
+ * Return the amount of kicks made by the last add
+ */
+int cuckoo_kicks(CuckooHash table) { return table->kicks; }
+
+
+/**
+ * Search given data in the cuckoo hash table, return the slot where it is or NULL
+*/
+void* *cuckoo_search_slot(CuckooHash table, void* data, unsigned hash) {
+
+    // In the first bucket
+    Bucket* bucket = &table->buckets[cuckoo_bucket(table, hash, 0)];
+    int slot = cuckoo_slot(table, bucket, data, hash);
+    if (slot != -1) return &bucket->data[slot];
+
+    // In the second bucket
+    bucket = &table->buckets[cuckoo_bucket(table, hash, 1)];
+    slot = cuckoo_slot(table, bucket, data, hash);
+    if (slot != -1) return &bucket->data[slot];
+
+    // In the stash
+    for (int i = 0; i < table->stashed; i++) {
+
+        if (table->stashHashes[i] == hash and table->compare(table->stash[i], data) == 0) return &table->stash[i];
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Search given data in the cuckoo hash table
+*/
+void* cuckoo_search(CuckooHash table, void* data) {
+
+    if (not table) return NULL;
+
+    void* *slot = cuckoo_search_slot(table, data, table->hash(data));
+
+    return slot exist ? *slot : NULL;
+}
+
+
+/**
+ * Add given data to the cuckoo hash table
+*/
+void cuckoo_add(CuckooHash table, void* data) {
+
+    if (not table) return;
+
+    unsigned hash = table->hash(data);
+    void* *slot = cuckoo_search_slot(table, data, hash);
+
+    table->kicks = 0;
+
+    // If data already exist in the table
+    if (slot exist) {
+
+        // Destroy to replace without lose memory
+        table->destroy(*slot);
+
+        // Replace data
+        *slot = table->copy(data);
+        return;
+    }
+
+    // Calculate the charge factor and evaluate if needs to rehash
+    if ((float) (table->stuffed + 1) / (float) cuckoo_capacity(table) > CUCKOO_OVERLOAD_CHARGE_FACTOR) {
+
+        cuckoo_rehash(table);
+    }
+
+    // Add data
+    void* carry = table->copy(data);
+    table->stuffed++;
+
+    // If there was no room, rebuild the table with the element left out
+    if (not cuckoo_place(table, &carry, &hash)) {
+
+        int kicks = table->kicks;
+        table->stuffed--;
+        cuckoo_rebuild(table, table->capacity, carry, hash);
+        table->kicks = kicks;
+    }
+}
+
+
+/**
+ * Delete given data from the cuckoo hash table
+*/
+void cuckoo_delete(CuckooHash table, void* data) {
+
+    if (not table) return;
+
+    unsigned hash = table->hash(data);
+    void* *slot = cuckoo_search_slot(table, data, hash);
+
+    // If data doesnt exist in the table
+    if (not slot) return;
+
+    table->destroy(*slot);
+    table->stuffed--;
+
+    // If data was in the stash, move the last element of the stash to its slot
+    if (slot >= table->stash and slot < table->stash + table->stashed) {
+
+        int i = slot - table->stash;
+
+        table->stashed--;
+        table->stash[i] = table->stash[table->stashed];
+        table->stashHashes[i] = table->stashHashes[table->stashed];
+        return;
+    }
+
+    *slot = NULL;
+
+    // Move back to the buckets the elements of the stash that fit now
+    for (int i = 0; i < table->stashed; ) {
+
+        unsigned stashHash = table->stashHashes[i];
+
+        if (cuckoo_put(&table->buckets[cuckoo_bucket(table, stashHash, 0)], table->stash[i], stashHash) or
+            cuckoo_put(&table->buckets[cuckoo_bucket(table, stashHash, 1)], table->stash[i], stashHash)) {
+
+            table->stashed--;
+            table->stash[i] = table->stash[table->stashed];
+            table->stashHashes[i] = table->stashHashes[table->stashed];
+        }
+
+        else i++;
+    }
+}
+
+
+/**
+ * Resize the cuckoo hash table at double of its capacity and rehash each of its elements
+*/
+void cuckoo_rehash(CuckooHash table) {
+
+    if (not table) return;
+
+    cuckoo_rebuild(table, table->capacity * 2, NULL, 0);
+}
+
+
+/**
+ * Print the cuckoo hash table
+*/
+void cuckoo_print(CuckooHash table) {
+
+    if (not table) return;
+
+    // Iterate through the buckets
+    for (int i = 0; i < table->capacity; i++) {
+
+        // At each bucket
+        printf("[%i]: ", i);
+
+        for (int j = 0; j < CUCKOO_WAYS; j++) {
+
+            // If data exist
+            if (table->buckets[i].data[j] exist) table->visit(table->buckets[i].data[j]);
+
+            // If doesnt exist
+            else printf("NULL");
+
+            printf(" ");
+        }
+
+        puts("");
+    }
+
+    // The stash
+    printf("Stash: ");
+    for (int i = 0; i < table->stashed; i++) {
+
+        table->visit(table->stash[i]);
+        printf(" ");
+    }
+
+    puts("");
+}
\ No newline at end of file
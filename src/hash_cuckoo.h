@@ -0,0 +1,160 @@
+#ifndef __HASH_CUCKOO_H__
+#define __HASH_CUCKOO_H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "void.h"
+#include "sugar.h"
+
+
+/**
+ * Hash table
+ *
+ * Cuckoo hashing: bucketized (4-way), with a stash
+ *
+ * Each element can only be in two buckets, chosen by two hashes of its data,
+ * and each bucket has room for CUCKOO_WAYS elements in one cache line.
+ * So a search reads at most two buckets (and the small stash, if it isnt empty).
+ * When both buckets of data are full, an element of one of them is kicked out
+ * to its other bucket, and so on, till some element finds room. If that takes
+ * too many kicks, the last one goes to the stash, and if the stash is full,
+ * the table is rebuilt with new hashes (or a bigger capacity).
+ * The hash function should tell apart the elements: more than 2 * CUCKOO_WAYS + CUCKOO_STASH
+ * elements with the same hash dont fit at any capacity. If a rebuild cant place all the
+ * elements after CUCKOO_MAX_REBUILDS tries, the ones left out go to the stash, that grows
+ * (and keeps taking the elements that dont fit) till the next rebuild.
+*/
+
+
+/**
+ * Amount of elements in each bucket
+*/
+#define CUCKOO_WAYS 4
+
+
+/**
+ * Amount of elements in the stash
+*/
+#define CUCKOO_STASH 4
+
+
+/**
+ * Max amount of kicks of an add before using the stash
+*/
+#define CUCKOO_MAX_KICKS 500
+
+
+/**
+ * Max amount of tries of a rebuild, with new hashes (the capacity doubles every two tries)
+*/
+#define CUCKOO_MAX_REBUILDS 6
+
+
+/**
+ * Struct of each bucket (in one cache line)
+*/
+typedef struct _Bucket {
+
+    unsigned hashes[CUCKOO_WAYS]; /* Hash of the data of each slot, to compare only data with the same hash */
+    void* data[CUCKOO_WAYS]; /* NULL in the empty slots */
+
+} __attribute__((aligned(64))) Bucket;
+
+
+/**
+ * Struct of the cuckoo hash table
+*/
+typedef struct _CuckooHash {
+
+    Bucket *buckets;
+    int capacity; /* Amount of buckets, always a power of two */
+    int stuffed;
+
+    unsigned seeds[2]; /* Seeds of the two hashes, they change when the table is rebuilt */
+    unsigned random; /* State to choose the elements to kick */
+
+    unsigned *stashHashes;
+    void* *stash;
+    int stashed;
+    int stashCapacity; /* CUCKOO_STASH, or more if it has grown */
+    int spilled; /* The last rebuild didnt place all the elements, so the stash takes any of them */
+
+    int kicks; /* Kicks made by the last add */
+
+    FunctionCopy copy;
+    FunctionDestroy destroy;
+    FunctionCompare compare;
+    FunctionVisit visit;
+    FunctionHash hash;
+
+} *CuckooHash;
+
+
+/**
+ * Overload charge factor to decide when to rehash
+*/
+#define CUCKOO_OVERLOAD_CHARGE_FACTOR 0.9
+
+
+/**
+ * Create an empty cuckoo hash table with room for the given amount of elements
+ * The amount of buckets is rounded up to a power of two
+*/
+CuckooHash cuckoo_create(int, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit, FunctionHash);
+
+
+/**
+ * Destroy the cuckoo hash table
+*/
+void cuckoo_destroy(CuckooHash);
+
+
+/**
+ * Return the capacity of the cuckoo hash table (slots in all the buckets)
+ */
+int cuckoo_capacity(CuckooHash);
+
+
+/**
+ * Return the amount of stuffed slots in the cuckoo hash table (with the stash)
+ */
+int cuckoo_stuffed(CuckooHash);
+
+
+/**
+ * Return the amount of kicks made by the last add
+ */
+int cuckoo_kicks(CuckooHash);
+
+
+/**
+ * Search given data in the cuckoo hash table
+*/
+void* cuckoo_search(CuckooHash, void*);
+
+
+/**
+ * Add given data to the cuckoo hash table
+*/
+void cuckoo_add(CuckooHash, void*);
+
+
+/**
+ * Delete given data from the cuckoo hash table
+*/
+void cuckoo_delete(CuckooHash, void*);
+
+
+/**
+ * Resize the cuckoo hash table at double of its capacity and rehash each of its elements
+*/
+void cuckoo_rehash(CuckooHash);
+
+
+/**
+ * Print the cuckoo hash table
+*/
+void cuckoo_print(CuckooHash);
+
+
+#endif
\ No newline at end of file
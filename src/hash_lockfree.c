@@ -0,0 +1,575 @@
+#include "hash_lockfree.h"
+#include "mix.h"
+#include <string.h>
+
+
+/**
+ * Lock free hash set
+ *
+ * Open hashing: split-ordered list
+*/
+
+
+/**
+ * Threads
+ *
+ * Each thread takes an index on its first operation on any lock free hash set,
+ * and gives it back when it finishes
+*/
+
+_Atomic int lfhash_used[LFHASH_MAX_THREADS];
+_Thread_local int lfhash_id = -1;
+pthread_key_t lfhash_key;
+pthread_once_t lfhash_once = PTHREAD_ONCE_INIT;
+
+
+/**
+ * Give back the index of a thread that finishes
+ * (the key keeps the index plus one, since NULL values arent given back)
+*/
+void lfhash_release(void* id) {
+
+    atomic_store(&lfhash_used[(intptr_t) id - 1], false);
+}
+
+
+/**
+ * Create the key to know when a thread finishes
+*/
+void lfhash_key_create() {
+
+    pthread_key_create(&lfhash_key, lfhash_release);
+}
+
+
+/**
+ * Return the index of the current thread, taking a free one on its first call
+*/
+int lfhash_thread() {
+
+    if (lfhash_id != -1) return lfhash_id;
+
+    pthread_once(&lfhash_once, lfhash_key_create);
+
+    for (int i = 0; i < LFHASH_MAX_THREADS and lfhash_id == -1; i++) {
+
+        int expected = false;
+        if (atomic_compare_exchange_strong(&lfhash_used[i], &expected, true)) lfhash_id = i;
+    }
+
+    if (lfhash_id == -1) {
+
+        fprintf(stderr, "Lock free hash set: more than %i threads\n", LFHASH_MAX_THREADS);
+        abort();
+    }
+
+    pthread_setspecific(lfhash_key, (void*) (intptr_t) (lfhash_id + 1));
+
+    return lfhash_id;
+}
+
+
+/**
+ * Epochs
+ *
+ * Each operation runs inside an epoch. A node unlinked at epoch e may be read
+ * by the operations that began at e - 1 and at e, so it is freed at epoch e + 2.
+ * The epoch advances when all the threads in an operation have seen it.
+*/
+
+/**
+ * Free the node (and destroy its data)
+*/
+void lfhash_free(LHash table, LList node) {
+
+    if (node->data exist) table->destroy(node->data);
+    free(node);
+}
+
+
+/**
+ * Free the nodes retired by the thread at some epoch
+*/
+void lfhash_free_bag(LHash table, LThread* thread, int bag) {
+
+    for (LList node = thread->bags[bag]; node exist; ) {
+
+        LList next = node->retired;
+        lfhash_free(table, node);
+        node = next;
+    }
+
+    thread->bags[bag] = NULL;
+}
+
+
+/**
+ * Advance the epoch if all the threads in an operation have seen it
+*/
+void lfhash_advance(LHash table) {
+
+    unsigned long epoch = atomic_load(&table->epoch);
+
+    for (int i = 0; i < LFHASH_MAX_THREADS; i++) {
+
+        LThread* thread = &table->threads[i];
+        if (atomic_load(&thread->active) and atomic_load(&thread->epoch) != epoch) return;
+    }
+
+    atomic_compare_exchange_strong(&table->epoch, &epoch, epoch + 1);
+}
+
+
+/**
+ * Begin an operation of the current thread, and free its nodes retired long enough ago
+*/
+LThread* lfhash_enter(LHash table) {
+
+    LThread* thread = &table->threads[lfhash_thread()];
+
+    atomic_store(&thread->active, true);
+    atomic_store(&thread->epoch, atomic_load(&table->epoch));
+
+    // The stores go before any read of the list (atomics are sequentially consistent)
+    unsigned long epoch = atomic_load(&thread->epoch);
+
+    for (int bag = 0; bag < 3; bag++) {
+
+        if (thread->bags[bag] exist and thread->bagEpochs[bag] + 2 <= epoch)
+            lfhash_free_bag(table, thread, bag);
+    }
+
+    return thread;
+}
+
+
+/**
+ * End an operation of the current thread
+*/
+void lfhash_exit(LThread* thread) {
+
+    atomic_store(&thread->active, false);
+}
+
+
+/**
+ * Retire an unlinked node, to free when no thread can read it
+*/
+void lfhash_retire(LHash table, LThread* thread, LList node) {
+
+    unsigned long epoch = atomic_load(&table->epoch);
+    int bag = epoch % 3;
+
+    // If the bag has nodes of an old epoch (at least 3 epochs ago), free them first
+    if (thread->bags[bag] exist and thread->bagEpochs[bag] != epoch)
+        lfhash_free_bag(table, thread, bag);
+
+    node->retired = thread->bags[bag];
+    thread->bags[bag] = node;
+    thread->bagEpochs[bag] = epoch;
+
+    if (++thread->retired >= LFHASH_ADVANCE) {
+
+        thread->retired = 0;
+        lfhash_advance(table);
+    }
+}
+
+
+/**
+ * Keys
+*/
+
+/**
+ * Reverse the bits of x (the bits of a 32 bits value go to the high half)
+*/
+uint64_t lfhash_reverse(uint64_t x) {
+
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+
+    return __builtin_bswap64(x);
+}
+
+
+/**
+ * Key of a node with data of the given (mixed) hash
+*/
+uint64_t lfhash_data_key(unsigned hash) { return lfhash_reverse(hash) | 1; }
+
+
+/**
+ * Key of the dummy node of the given cell
+*/
+uint64_t lfhash_dummy_key(unsigned cell) { return lfhash_reverse(cell); }
+
+
+/**
+ * List
+*/
+
+/**
+ * Create a node with the key and data
+*/
+LList lfhash_node(uint64_t key, void* data) {
+
+    LList newNode = malloc(sizeof(struct _LNode));
+
+    newNode->key = key;
+    newNode->data = data;
+    atomic_init(&newNode->next, 0);
+    newNode->retired = NULL;
+
+    return newNode;
+}
+
+
+/**
+ * Search the key from the node start, unlinking (and retiring) the deleted nodes on the way
+ * Save on link the link to the first node not before the key, and on cur that node (or NULL)
+ * Return true if cur has the key (and equal data, if data is given), false otherwise
+*/
+int lfhash_find(LHash table, LThread* thread, LList start, uint64_t key, void* data, _Atomic uintptr_t* *link, LList *cur) {
+
+retry:
+
+    *link = &start->next;
+    uintptr_t curLink = atomic_load(*link);
+
+    while (true) {
+
+        LList node = (LList) curLink;
+
+        if (not node) {
+
+            *cur = NULL;
+            return false;
+        }
+
+        uintptr_t next = atomic_load(&node->next);
+
+        // If node is deleted, unlink it (if the link changed meanwhile, start again)
+        if (next & 1) {
+
+            if (not atomic_compare_exchange_strong(*link, &curLink, next & ~(uintptr_t) 1)) goto retry;
+
+            lfhash_retire(table, thread, node);
+            curLink = next & ~(uintptr_t) 1;
+            continue;
+        }
+
+        // If the key goes before node, or node has it
+        if (node->key > key or (node->key == key and (not data or table->compare(node->data, data) == 0))) {
+
+            *cur = node;
+            return node->key == key;
+        }
+
+        *link = &node->next;
+        curLink = next;
+    }
+}
+
+
+/**
+ * Return the dummy node of the given cell, adding it if the cell isnt initialized
+ * (after the dummy node of its parent cell, the cell without its highest bit)
+*/
+LList lfhash_cell(LHash table, LThread* thread, unsigned cell) {
+
+    // Segment of the cell, asked if it doesnt exist
+    _Atomic(LCell*) *segmentLink = &table->segments[cell / LFHASH_SEGMENT];
+    LCell* segment = atomic_load(segmentLink);
+
+    if (not segment) {
+
+        LCell* newSegment = calloc(LFHASH_SEGMENT, sizeof(LCell));
+
+        // If other thread asked it first, use that one
+        if (atomic_compare_exchange_strong(segmentLink, &segment, newSegment)) segment = newSegment;
+        else free(newSegment);
+    }
+
+    LList dummy = atomic_load(&segment[cell % LFHASH_SEGMENT]);
+    if (dummy exist) return dummy;
+
+    // Initialize the cell after its parent
+    LList parent = lfhash_cell(table, thread, cell & ~(1u << (31 - __builtin_clz(cell))));
+
+    LList newDummy = lfhash_node(lfhash_dummy_key(cell), NULL);
+
+    while (true) {
+
+        _Atomic uintptr_t* link;
+        LList cur;
+
+        // If other thread added it first, use that one
+        if (lfhash_find(table, thread, parent, newDummy->key, NULL, &link, &cur)) {
+
+            free(newDummy);
+            dummy = cur;
+            break;
+        }
+
+        uintptr_t expected = (uintptr_t) cur;
+        atomic_store(&newDummy->next, expected);
+
+        if (atomic_compare_exchange_strong(link, &expected, (uintptr_t) newDummy)) {
+
+            dummy = newDummy;
+            break;
+        }
+    }
+
+    atomic_store(&segment[cell % LFHASH_SEGMENT], dummy);
+
+    return dummy;
+}
+
+
+/**
+ * Return the dummy node of the cell of the given (mixed) hash
+*/
+LList lfhash_start(LHash table, LThread* thread, unsigned hash) {
+
+    return lfhash_cell(table, thread, hash & (atomic_load(&table->cells) - 1));
+}
+
+
+/**
+ * Create an empty lock free hash set
+ * The amount of cells is rounded up to a power of two
+*/
+LHash lfhash_create(int cells, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash) {
+
+    // Ask memory for the hash set, aligned as its threads so each one has its own cache line
+    LHash newTable = aligned_alloc(_Alignof(struct _LHash), sizeof(struct _LHash));
+    memset(newTable, 0, sizeof(struct _LHash));
+
+    int rounded = 1;
+    while (rounded < cells and rounded < LFHASH_SEGMENT * LFHASH_SEGMENTS) rounded *= 2;
+
+    atomic_init(&newTable->cells, rounded);
+    atomic_init(&newTable->stuffed, 0);
+    atomic_init(&newTable->epoch, 0);
+
+    // The cell 0 begins the list
+    LCell* segment = calloc(LFHASH_SEGMENT, sizeof(LCell));
+    atomic_init(&segment[0], lfhash_node(lfhash_dummy_key(0), NULL));
+    atomic_init(&newTable->segments[0], segment);
+
+    newTable->copy = copy;
+    newTable->destroy = destroy;
+    newTable->compare = compare;
+    newTable->visit = visit;
+    newTable->hash = hash;
+
+    return newTable;
+}
+
+
+/**
+ * Destroy the lock free hash set (no other thread may use it)
+*/
+void lfhash_destroy(LHash table) {
+
+    if (not table) return;
+
+    // Free the nodes of the list (from the dummy node of the cell 0)
+    LList node = atomic_load(&atomic_load(&table->segments[0])[0]);
+    while (node exist) {
+
+        LList next = (LList) (atomic_load(&node->next) & ~(uintptr_t) 1);
+        lfhash_free(table, node);
+        node = next;
+    }
+
+    // Free the retired nodes
+    for (int i = 0; i < LFHASH_MAX_THREADS; i++) {
+
+        for (int bag = 0; bag < 3; bag++) lfhash_free_bag(table, &table->threads[i], bag);
+    }
+
+    for (int i = 0; i < LFHASH_SEGMENTS; i++) free(atomic_load(&table->segments[i]));
+
+    free(table);
+}
+
+
+/**
+ * Return the amount of cells of the lock free hash set
+ */
+int lfhash_capacity(LHash table) { return atomic_load(&table->cells); }
+
+
+/**
+ * Return the amount of elements in the lock free hash set
+ */
+int lfhash_stuffed(LHash table) { return atomic_load(&table->stuffed); }
+
+
+/**
+ * Return true if given data is in the lock free hash set, false otherwise
+*/
+int lfhash_contains(LHash table, void* data) {
+
+    if (not table) return false;
+
+    unsigned hash = hash_mix(table->hash(data));
+
+    LThread* thread = lfhash_enter(table);
+
+    _Atomic uintptr_t* link;
+    LList cur;
+    int found = lfhash_find(table, thread, lfhash_start(table, thread, hash), lfhash_data_key(hash), data, &link, &cur);
+
+    lfhash_exit(thread);
+
+    return found;
+}
+
+
+/**
+ * Search given data in the lock free hash set
+ * Return a copy of data of the set (to destroy by the caller), or NULL if it isnt on it
+*/
+void* lfhash_search(LHash table, void* data) {
+
+    if (not table) return NULL;
+
+    unsigned hash = hash_mix(table->hash(data));
+
+    LThread* thread = lfhash_enter(table);
+
+    _Atomic uintptr_t* link;
+    LList cur;
+    int found = lfhash_find(table, thread, lfhash_start(table, thread, hash), lfhash_data_key(hash), data, &link, &cur);
+
+    // Copy data while the node cant be freed
+    void* copy = found ? table->copy(cur->data) : NULL;
+
+    lfhash_exit(thread);
+
+    return copy;
+}
+
+
+/**
+ * Add a copy of given data to the lock free hash set
+ * Return true if it was added, false if data was already on it (then nothing changes)
+*/
+int lfhash_add(LHash table, void* data) {
+
+    if (not table) return false;
+
+    unsigned hash = hash_mix(table->hash(data));
+    uint64_t key = lfhash_data_key(hash);
+
+    LThread* thread = lfhash_enter(table);
+
+    LList start = lfhash_start(table, thread, hash);
+    LList newNode = NULL;
+
+    while (true) {
+
+        _Atomic uintptr_t* link;
+        LList cur;
+
+        // If data already exist in the set
+        if (lfhash_find(table, thread, start, key, data, &link, &cur)) {
+
+            if (newNode exist) lfhash_free(table, newNode);
+
+            lfhash_exit(thread);
+            return false;
+        }
+
+        if (not newNode) newNode = lfhash_node(key, table->copy(data));
+
+        // Link the node before cur (if the link changed meanwhile, search again)
+        uintptr_t expected = (uintptr_t) cur;
+        atomic_store(&newNode->next, expected);
+
+        if (atomic_compare_exchange_strong(link, &expected, (uintptr_t) newNode)) break;
+    }
+
+    // Calculate the charge factor and evaluate if needs to double the amount of cells
+    // (the new cells are initialized by the first operation on each one)
+    int cells = atomic_load(&table->cells);
+    if (atomic_fetch_add(&table->stuffed, 1) + 1 > LFHASH_LOAD * cells and cells < LFHASH_SEGMENT * LFHASH_SEGMENTS)
+        atomic_compare_exchange_strong(&table->cells, &cells, cells * 2);
+
+    lfhash_exit(thread);
+    return true;
+}
+
+
+/**
+ * Delete given data from the lock free hash set
+ * Return true if it was deleted, false if data wasnt on it
+*/
+int lfhash_delete(LHash table, void* data) {
+
+    if (not table) return false;
+
+    unsigned hash = hash_mix(table->hash(data));
+    uint64_t key = lfhash_data_key(hash);
+
+    LThread* thread = lfhash_enter(table);
+
+    LList start = lfhash_start(table, thread, hash);
+
+    while (true) {
+
+        _Atomic uintptr_t* link;
+        LList cur;
+
+        // If data doesnt exist in the set
+        if (not lfhash_find(table, thread, start, key, data, &link, &cur)) {
+
+            lfhash_exit(thread);
+            return false;
+        }
+
+        // Mark the node as deleted (if other thread marked it first, search again)
+        uintptr_t next = atomic_load(&cur->next);
+        if (next & 1) continue;
+        if (not atomic_compare_exchange_strong(&cur->next, &next, next | 1)) continue;
+
+        // Unlink it, or search again to unlink it
+        uintptr_t expected = (uintptr_t) cur;
+        if (atomic_compare_exchange_strong(link, &expected, next)) lfhash_retire(table, thread, cur);
+        else lfhash_find(table, thread, start, key, data, &link, &cur);
+
+        break;
+    }
+
+    atomic_fetch_sub(&table->stuffed, 1);
+
+    lfhash_exit(thread);
+    return true;
+}
+
+
+/**
+ * Print the elements of the lock free hash set, in the order of the list
+ * (no other thread may change it meanwhile)
+*/
+void lfhash_print(LHash table) {
+
+    if (not table) return;
+
+    LList node = atomic_load(&atomic_load(&table->segments[0])[0]);
+    for (; node exist; node = (LList) (atomic_load(&node->next) & ~(uintptr_t) 1)) {
+
+        // Print data (not the dummy nodes)
+        if (node->data exist) {
+
+            table->visit(node->data);
+            printf(" ");
+        }
+    }
+
+    puts("");
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#ifndef __HASH_LOCKFREE_H__
+#define __HASH_LOCKFREE_H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "void.h"
+#include "sugar.h"
+
+
+/**
+ * Lock free hash set
+ *
+ * Open hashing: split-ordered list (Shalev and Shavit)
+ *
+ * All the elements are in one lock free linked list (Harris and Michael), sorted by
+ * the bits of their hash reversed, so the elements of each cell are together.
+ * Each cell points to a dummy node at the begin of its elements, and when the
+ * amount of cells doubles, the new cells get dummy nodes in the middle of the
+ * elements of the old ones: resizing never moves nodes.
+ *
+ * A deleted node is marked (lowest bit of its link to the next node) before it is
+ * unlinked, and freed with epochs: it is freed when all the threads that could still
+ * be reading it have finished their operation. Searches never wait for other threads.
+*/
+
+
+/**
+ * Cells of each segment, and max amount of segments
+ * (the cells are asked by segments, so they never move)
+*/
+#define LFHASH_SEGMENT 1024
+#define LFHASH_SEGMENTS 4096
+
+
+/**
+ * Max amount of threads using lock free hash sets at the same time
+*/
+#define LFHASH_MAX_THREADS 128
+
+
+/**
+ * Average of elements per cell to double the amount of cells
+*/
+#define LFHASH_LOAD 2
+
+
+/**
+ * Nodes retired by a thread between tries to advance the epoch
+*/
+#define LFHASH_ADVANCE 64
+
+
+/**
+ * Struct of each node of the list
+*/
+typedef struct _LNode {
+
+    uint64_t key; /* Bits of the hash reversed, odd for data and even for dummy nodes */
+    void* data; /* NULL in dummy nodes */
+    _Atomic uintptr_t next; /* Next node, with the lowest bit on if this node is deleted */
+    struct _LNode *retired; /* Next retired node of the same thread, waiting to be freed */
+
+} *LList;
+
+
+/**
+ * Cell of the table, the dummy node where its elements begin (or NULL if its not initialized)
+*/
+typedef _Atomic(LList) LCell;
+
+
+/**
+ * Struct of each thread on a table (on its own cache line)
+*/
+typedef struct _LThread {
+
+    _Atomic int active; /* If the thread is in an operation */
+    _Atomic unsigned long epoch; /* Epoch seen by the thread at the begin of the operation */
+
+    LList bags[3]; /* Nodes retired by the thread, by epoch */
+    unsigned long bagEpochs[3];
+    int retired; /* Nodes retired since the last try to advance the epoch */
+
+} __attribute__((aligned(64))) LThread;
+
+
+/**
+ * Struct of the lock free hash set
+*/
+typedef struct _LHash {
+
+    _Atomic(LCell*) segments[LFHASH_SEGMENTS];
+
+    _Atomic int cells; /* Always a power of two */
+    _Atomic int stuffed;
+
+    _Atomic unsigned long epoch;
+    LThread threads[LFHASH_MAX_THREADS];
+
+    FunctionCopy copy;
+    FunctionDestroy destroy;
+    FunctionCompare compare;
+    FunctionVisit visit;
+    FunctionHash hash;
+
+} *LHash;
+
+
+/**
+ * Create an empty lock free hash set
+ * The amount of cells is rounded up to a power of two
+*/
+LHash lfhash_create(int, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit, FunctionHash);
+
+
+/**
+ * Destroy the lock free hash set (no other thread may use it)
+*/
+void lfhash_destroy(LHash);
+
+
+/**
+ * Return the amount of cells of the lock free hash set
+ */
+int lfhash_capacity(LHash);
+
+
+/**
+ * Return the amount of elements in the lock free hash set
+ */
+int lfhash_stuffed(LHash);
+
+
+/**
+ * Return true if given data is in the lock free hash set, false otherwise
+*/
+int lfhash_contains(LHash, void*);
+
+
+/**
+ * Search given data in the lock free hash set
+ * Return a copy of data of the set (to destroy by the caller), or NULL if it isnt on it
+*/
+void* lfhash_search(LHash, void*);
+
+
+/**
+ * Add a copy of given data to the lock free hash set
+ * Return true if it was added, false if data was already on it (then nothing changes)
+*/
+int lfhash_add(LHash, void*);
+
+
+/**
+ * Delete given data from the lock free hash set
+ * Return true if it was deleted, false if data wasnt on it
+*/
+int lfhash_delete(LHash, void*);
+
+
+/**
+ * Print the elements of the lock free hash set, in the order of the list
+ * (no other thread may change it meanwhile)
+*/
+void lfhash_print(LHash);
+
+
+#endif
\ No newline at end of file
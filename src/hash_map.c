@@ -0,0 +1,271 @@
+#include "hash_map.h"
+
+
+/**
+ * Hash map
+ *
+ * Pairs of key and value on a closed hashing table
+*/
+
+
+/**
+ * Functions of the pairs for the table (they use the functions of the keys of its map)
+*/
+
+/**
+ * Create a pair with a copy of the key and of the value (if it exist)
+*/
+Pair pair_create(Map map, void* key, void* value) {
+
+    Pair newPair = malloc(sizeof(struct _Pair));
+
+    newPair->key = map->copyKey(key);
+    newPair->value = value exist ? map->copyValue(value) : NULL;
+    newPair->map = map;
+
+    return newPair;
+}
+
+
+/**
+ * Auxiliar "copy" function of the pairs
+ * (the map creates the pairs, the table never copies them)
+*/
+void* pair_pointer(void* pair) {
+
+    return pair;
+}
+
+
+/**
+ * Destroy the pair, its key and its value
+*/
+void pair_destroy(void* data) {
+
+    Pair pair = data;
+
+    pair->map->destroyKey(pair->key);
+    if (pair->value exist) pair->map->destroyValue(pair->value);
+
+    free(pair);
+}
+
+
+/**
+ * Compare the keys of the pairs
+*/
+int pair_compare(void* a, void* b) {
+
+    return ((Pair) a)->map->compare(((Pair) a)->key, ((Pair) b)->key);
+}
+
+
+/**
+ * Print the key and the value of the pair
+*/
+void pair_visit(void* data) {
+
+    Pair pair = data;
+
+    pair->map->visitKey(pair->key);
+    printf(": ");
+
+    if (pair->value exist) pair->map->visitValue(pair->value);
+    else printf("NULL");
+}
+
+
+/**
+ * Hash the key of the pair
+*/
+unsigned pair_hash(void* data) {
+
+    return ((Pair) data)->map->hash(((Pair) data)->key);
+}
+
+
+/**
+ * Create an empty map
+*/
+Map map_create(int capacity, ProbingType type, FunctionCopy copyKey, FunctionDestroy destroyKey, FunctionCopy copyValue, FunctionDestroy destroyValue, FunctionCompare compare, FunctionVisit visitKey, FunctionVisit visitValue, FunctionHash hash) {
+
+    Map newMap = malloc(sizeof(struct _Map));
+
+    newMap->table = hash_create(capacity, type, pair_pointer, pair_destroy, pair_compare, pair_visit, pair_hash);
+
+    newMap->copyKey = copyKey;
+    newMap->destroyKey = destroyKey;
+    newMap->copyValue = copyValue;
+    newMap->destroyValue = destroyValue;
+    newMap->compare = compare;
+    newMap->visitKey = visitKey;
+    newMap->visitValue = visitValue;
+    newMap->hash = hash;
+
+    return newMap;
+}
+
+
+/**
+ * Destroy the map
+*/
+void map_destroy(Map map) {
+
+    if (not map) return;
+
+    hash_destroy(map->table);
+    free(map);
+}
+
+
+/**
+ * Return the amount of pairs in the map
+ */
+int map_size(Map map) { return hash_stuffed(map->table); }
+
+
+/**
+ * Return the value of the key, or NULL if the key isnt in the map
+*/
+void* map_get(Map map, void* key) {
+
+    if (not map) return NULL;
+
+    // Pair to search the key
+    struct _Pair search = {key, NULL, map};
+
+    Pair pair = hash_search(map->table, &search);
+
+    return pair exist ? pair->value : NULL;
+}
+
+
+/**
+ * Return the slot of the pair of the key, and save on found if the key was already in the map
+ * If the key isnt in the map, the caller must put a pair with it on the slot
+*/
+void* *map_slot(Map map, void* key, int* found) {
+
+    // Pair to search the key
+    struct _Pair search = {key, NULL, map};
+
+    return hash_slot(map->table, &search, found);
+}
+
+
+/**
+ * Put a copy of the value at the key (replacing the value it had)
+*/
+void map_put(Map map, void* key, void* value) {
+
+    if (not map) return;
+
+    int found;
+    void* *slot = map_slot(map, key, &found);
+
+    // If the key already exist in the map
+    if (found) {
+
+        Pair pair = *slot;
+
+        // Destroy to replace without lose memory
+        if (pair->value exist) map->destroyValue(pair->value);
+
+        // Replace value
+        pair->value = value exist ? map->copyValue(value) : NULL;
+    }
+
+    // If the key doesnt exist in the map
+    else {
+
+        *slot = pair_create(map, key, value);
+    }
+}
+
+
+/**
+ * Return the slot of the value of the key
+ * If the key isnt in the map, it is added with a copy of the given value (or NULL)
+*/
+void* *map_get_or_insert(Map map, void* key, void* value) {
+
+    if (not map) return NULL;
+
+    int found;
+    void* *slot = map_slot(map, key, &found);
+
+    // If the key doesnt exist in the map
+    if (not found) *slot = pair_create(map, key, value);
+
+    return &((Pair) *slot)->value;
+}
+
+
+/**
+ * Put at the key the value returned by the function, given the value of the key and the argument
+ * (the old value goes to the function, which may update it and return it)
+*/
+void map_upsert(Map map, void* key, FunctionUpsert upsert, void* argument) {
+
+    if (not map) return;
+
+    int found;
+    void* *slot = map_slot(map, key, &found);
+
+    // If the key doesnt exist in the map, add it without value
+    if (not found) *slot = pair_create(map, key, NULL);
+
+    Pair pair = *slot;
+    pair->value = upsert(pair->value, argument);
+}
+
+
+/**
+ * Remove the key from the map and return its value (without destroy it), or NULL if the key isnt in the map
+*/
+void* map_remove_and_take(Map map, void* key) {
+
+    if (not map) return NULL;
+
+    // Pair to search the key
+    struct _Pair search = {key, NULL, map};
+
+    Pair pair = hash_take(map->table, &search);
+
+    // If the key doesnt exist in the map
+    if (not pair) return NULL;
+
+    void* value = pair->value;
+
+    map->destroyKey(pair->key);
+    free(pair);
+
+    return value;
+}
+
+
+/**
+ * Print the map
+*/
+void map_print(Map map) {
+
+    if (not map) return;
+
+    // Iterate through the table
+    for (int i = 0; i < map->table->capacity; i++) {
+
+        // If there is a pair on the cell
+        if (map->table->array[i].data exist) {
+
+            pair_visit(map->table->array[i].data);
+            puts("");
+        }
+    }
+
+    // And through the overflow (only for hopscotch)
+    for (int i = 0; i < map->table->overflowed; i++) {
+
+        pair_visit(map->table->overflow[i].data);
+        puts("");
+    }
+}
\ No newline at end of file
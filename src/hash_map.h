@@ -0,0 +1,112 @@
+#ifndef __HASH_MAP_H__
+#define __HASH_MAP_H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "void.h"
+#include "sugar.h"
+#include "hash_probing.h"
+
+
+/**
+ * Hash map
+ *
+ * Pairs of key and value on a closed hashing table, searched by the key.
+ * Each operation probes the table once (hash_slot and hash_take).
+*/
+
+
+/**
+ * Function to upsert: given the value of the key (NULL if there is none)
+ * and the extra argument, return the new value (the map doesnt copy it)
+*/
+typedef void *(*FunctionUpsert)(void*, void*);
+
+
+/**
+ * Struct of each pair of the map
+*/
+typedef struct _Pair {
+
+    void* key;
+    void* value;
+    struct _Map *map; /* Map of the pair, to reach the functions of the key */
+
+} *Pair;
+
+
+/**
+ * Struct of the map
+*/
+typedef struct _Map {
+
+    Hash table; /* Table of pairs */
+
+    FunctionCopy copyKey;
+    FunctionDestroy destroyKey;
+    FunctionCopy copyValue;
+    FunctionDestroy destroyValue;
+    FunctionCompare compare; /* Of the keys */
+    FunctionVisit visitKey;
+    FunctionVisit visitValue;
+    FunctionHash hash; /* Of the keys */
+
+} *Map;
+
+
+/**
+ * Create an empty map
+*/
+Map map_create(int, ProbingType, FunctionCopy, FunctionDestroy, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit, FunctionVisit, FunctionHash);
+
+
+/**
+ * Destroy the map
+*/
+void map_destroy(Map);
+
+
+/**
+ * Return the amount of pairs in the map
+ */
+int map_size(Map);
+
+
+/**
+ * Return the value of the key, or NULL if the key isnt in the map
+*/
+void* map_get(Map, void*);
+
+
+/**
+ * Put a copy of the value at the key (replacing the value it had)
+*/
+void map_put(Map, void*, void*);
+
+
+/**
+ * Return the slot of the value of the key
+ * If the key isnt in the map, it is added with a copy of the given value (or NULL)
+*/
+void* *map_get_or_insert(Map, void*, void*);
+
+
+/**
+ * Put at the key the value returned by the function, given the value of the key and the argument
+*/
+void map_upsert(Map, void*, FunctionUpsert, void*);
+
+
+/**
+ * Remove the key from the map and return its value (without destroy it), or NULL if the key isnt in the map
+*/
+void* map_remove_and_take(Map, void*);
+
+
+/**
+ * Print the map
+*/
+void map_print(Map);
+
+
+#endif
\ No newline at end of file
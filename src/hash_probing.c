@@ -1,4 +1,5 @@
 #include "hash_probing.h"
+#include "mix.h"
 
 
 /**
@@ -8,28 +9,109 @@
 */
 
 
+/**
+ * Greatest common divisor
+*/
+int gcd(int a, int b) {
+
+    while (b != 0) {
+
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+
+    return a;
+}
+
+
+/**
+ * Round up the capacity to a power of two
+*/
+int hash_round_capacity(int capacity) {
+
+    int rounded = 1;
+    while (rounded < capacity) rounded *= 2;
+
+    return rounded;
+}
+
+
+/**
+ * Return the home index of the given hash
+ * (a mask of the mixed hash if the capacity is a power of two, the modulo otherwise)
+*/
+int hash_index(Hash table, unsigned hash) {
+
+    if (table->powerOfTwo) return hash_mix(hash) & (table->capacity - 1);
+
+    return hash % table->capacity;
+}
+
+
+/**
+ * Return the given index wrapped around the capacity
+*/
+int hash_wrap(Hash table, int idx) {
+
+    if (table->powerOfTwo) return idx & (table->capacity - 1);
+
+    return idx % table->capacity;
+}
+
+
+/**
+ * Step of the probing for double hashing
+ * 
+ * The hash is mixed again (murmur3 finalizer) to take the step, and the
+ * step is kept co-prime with the capacity, so the probing goes through all the cells
+*/
+int probing_step(unsigned hash, int capacity) {
+
+    if (capacity < 2) return 1;
+
+    // Mix the bits of the hash
+    hash = hash_mix(hash);
+
+    // Step between 1 and capacity - 1
+    int step = 1 + hash % (capacity - 1);
+
+    // If the capacity is a power of two, any odd step is co-prime with it
+    if ((capacity & (capacity - 1)) == 0) return step | 1;
+
+    // Otherwise look for a step co-prime with the capacity (1 always is)
+    while (gcd(step, capacity) != 1) step--;
+
+    return step;
+}
+
+
 /**
  * Apply some probing
+ * 
+ * The step of double hashing is calculated on the first call (while it is 0), so the
+ * searches that hit at the home cell dont pay for it
 */
-int probing(int x, int i, int capacity, ProbingType type) {
+int probing(Hash table, int x, int i, unsigned hash, int* step) {
 
     // Linear probing
-    if (type == LINEAR) {
+    if (table->type == LINEAR) {
 
-        return (x + 1) % capacity;
+        return hash_wrap(table, x + 1);
     }
 
     // Cuadratic probing
-    else if (type == CUADRATIC) {
+    else if (table->type == CUADRATIC) {
 
-        return (x + C1 * i + C2 *i*i) % capacity;
+        return hash_wrap(table, x + C1 * i + C2 *i*i);
     }
     
     // Double hashing
-    // (!) May define some proper CO_PRIME to work
-    else if (type == DOUBLE_HASHING) {
+    else if (table->type == DOUBLE_HASHING) {
+
+        if (not *step) *step = probing_step(hash, table->capacity);
 
-        return CO_PRIME - (x % CO_PRIME);
+        return hash_wrap(table, x + *step);
     }
     
     // None of the probing options 
@@ -40,6 +122,428 @@ int probing(int x, int i, int capacity, ProbingType type) {
 }
 
 
+/**
+ * Return true if the cell at the index has the given data, false otherwise
+ * (compare is only called when the hash of the cell is the same)
+*/
+int hash_match(Hash table, int idx, void* data, unsigned hash) {
+
+    return table->array[idx].data exist and table->array[idx].hash == hash and
+        table->compare(table->array[idx].data, data) == 0;
+}
+
+
+/**
+ * Robin Hood probing
+ * 
+ * Linear probing where each cell keeps the distance of its element to its home cell.
+ * When adding, data takes the cell of any richer element (closer to its home) and
+ * that element keeps moving forward instead, so the distances stay all alike.
+ * A search stops as soon as it reaches an element richer than data would be there,
+ * and deleting shifts back the rest of the cluster, so there are no deleted cells.
+*/
+
+/**
+ * Search given data in the Robin Hood hash table, return true if finds it, false otherwise
+ * Save the index of data, or the index and distance where data would go
+*/
+int robin_hood_search(Hash table, void* data, unsigned hash, int* idx, int* distance) {
+
+    // Calculate key of data
+    *idx = hash_index(table, hash);
+    *distance = 0;
+
+    // While there are elements not richer than data would be
+    table->probes = 1;
+    while (table->array[*idx].data exist and table->array[*idx].distance >= *distance) {
+
+        // If data found
+        if (hash_match(table, *idx, data, hash)) return true;
+
+        *idx = hash_wrap(table, *idx + 1);
+        (*distance)++;
+        table->probes++;
+    }
+
+    return false;
+}
+
+
+/**
+ * Return the slot of given data, with its hash, in the Robin Hood hash table
+ * (see hash_slot)
+*/
+void* *robin_hood_slot(Hash table, void* data, unsigned hash, int* found) {
+
+    int idx, distance;
+
+    // If data already exist in the table
+    *found = robin_hood_search(table, data, hash, &idx, &distance);
+    if (*found) return &table->array[idx].data;
+
+    // If there is no room for data, rehash and search again
+    if (table->stuffed == table->capacity) {
+
+        hash_rehash(table);
+        robin_hood_search(table, data, hash, &idx, &distance);
+    }
+
+    // Move forward the richer elements till some empty cell
+    // (data stays at the first cell taken, that is its slot)
+    void* carry = data;
+    int slot = -1;
+    while (table->array[idx].data exist) {
+
+        // Take the cell of the richer element, and keep moving it
+        if (table->array[idx].distance < distance) {
+
+            if (slot == -1) slot = idx;
+
+            void* auxData = table->array[idx].data;
+            unsigned auxHash = table->array[idx].hash;
+            int auxDistance = table->array[idx].distance;
+
+            table->array[idx].data = carry;
+            table->array[idx].hash = hash;
+            table->array[idx].distance = distance;
+
+            carry = auxData;
+            hash = auxHash;
+            distance = auxDistance;
+        }
+
+        idx = hash_wrap(table, idx + 1);
+        distance++;
+    }
+
+    // Add data
+    table->array[idx].data = carry;
+    table->array[idx].hash = hash;
+    table->array[idx].distance = distance;
+    table->array[idx].deleted = false;
+    table->stuffed++;
+
+    return &table->array[slot == -1 ? idx : slot].data;
+}
+
+
+/**
+ * Take given data out of the Robin Hood hash table (without destroy it)
+ * Return data of the table, or NULL if it isnt on it
+*/
+void* robin_hood_take(Hash table, void* data) {
+
+    int idx, distance;
+
+    // If data doesnt exist in the table
+    if (not robin_hood_search(table, data, table->hash(data), &idx, &distance)) return NULL;
+
+    // Take data
+    void* taken = table->array[idx].data;
+
+    // Shift back the next elements of the cluster which are not at home
+    int next = hash_wrap(table, idx + 1);
+    while (table->array[next].data exist and table->array[next].distance > 0) {
+
+        table->array[idx].data = table->array[next].data;
+        table->array[idx].hash = table->array[next].hash;
+        table->array[idx].distance = table->array[next].distance - 1;
+
+        idx = next;
+        next = hash_wrap(table, next + 1);
+    }
+
+    // The last cell of the cluster is free now
+    table->array[idx].data = NULL;
+    table->array[idx].distance = 0;
+    table->stuffed--;
+
+    return taken;
+}
+
+
+/**
+ * Hopscotch probing
+ *
+ * Linear probing where each element stays at less than HOP_RANGE cells from its home cell,
+ * and each home cell keeps a bitmap of the cells of its neighbourhood with its elements.
+ * A search only compares the cells of the bitmap, so it is short even at high loads.
+ * When adding, if the first empty cell is too far, it is moved back by swapping it
+ * with some element that can go there without leaving its own neighbourhood.
+ * The few elements that cant get into their neighbourhood go to a small overflow,
+ * that is only searched from the home cells with elements on it.
+ * Deleting clears the cell and its bit, and moves back into it an element from further
+ * on (and so on), so the elements stay close to their home and there are no deleted cells.
+*/
+
+/**
+ * Return the size of the neighbourhoods (the capacity, in tables smaller than HOP_RANGE)
+*/
+int hopscotch_range(Hash table) {
+
+    return table->capacity < HOP_RANGE ? table->capacity : HOP_RANGE;
+}
+
+
+/**
+ * Return the max amount of elements in the overflow before rehash
+*/
+int hopscotch_overflow_limit(Hash table) {
+
+    int limit = table->capacity / HOP_OVERFLOW_CELLS;
+
+    return limit > HOP_OVERFLOW ? limit : HOP_OVERFLOW;
+}
+
+
+/**
+ * Search given data in the hopscotch hash table, return its cell (in the table
+ * or in the overflow) or NULL if it isnt on it
+*/
+Cell hopscotch_search(Hash table, void* data, unsigned hash) {
+
+    int home = hash_index(table, hash);
+
+    // Compare only the cells of the neighbourhood with elements of this home cell
+    table->probes = 1;
+    for (unsigned hop = table->array[home].hop; hop; hop &= hop - 1, table->probes++) {
+
+        int idx = hash_wrap(table, home + __builtin_ctz(hop));
+        if (hash_match(table, idx, data, hash)) return &table->array[idx];
+    }
+
+    // If some element of this home cell is in the overflow
+    if (table->array[home].distance > 0) {
+
+        for (int i = 0; i < table->overflowed; i++, table->probes++) {
+
+            Cell cell = &table->overflow[i];
+            if (cell->hash == hash and table->compare(cell->data, data) == 0) return cell;
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Add data (without copy it) to the overflow of the hopscotch hash table, return its cell
+*/
+Cell hopscotch_overflow(Hash table, void* data, unsigned hash, int home) {
+
+    // Ask memory for more room
+    if (table->overflowed == table->overflowCapacity) {
+
+        table->overflowCapacity = table->overflowCapacity ? table->overflowCapacity * 2 : 4;
+        table->overflow = realloc(table->overflow, sizeof(struct _Cell) * table->overflowCapacity);
+    }
+
+    Cell cell = &table->overflow[table->overflowed++];
+    cell->data = data;
+    cell->hash = hash;
+
+    table->array[home].distance++;
+    table->stuffed++;
+
+    return cell;
+}
+
+
+/**
+ * Place data (without copy it) in the neighbourhood of its home cell, moving
+ * other elements if needed, return its index or -1 if there is no room
+*/
+int hopscotch_place(Hash table, void* data, unsigned hash) {
+
+    // Search the first empty cell from the home cell
+    int home = hash_index(table, hash);
+    int distance = 0;
+
+    int idx = home;
+    while (table->array[idx].data exist) {
+
+        idx = hash_wrap(table, idx + 1);
+        distance++;
+    }
+
+    // Move the empty cell back till it is in the neighbourhood
+    int range = hopscotch_range(table);
+    while (distance >= range) {
+
+        // Look for the furthest home cell, before the empty one, with an element
+        // it can move to the empty cell (that is, some element before it)
+        int moved = false;
+        for (int far = range - 1; far > 0 and not moved; far--) {
+
+            Cell owner = &table->array[hash_wrap(table, idx - far + table->capacity)];
+            unsigned hop = owner->hop & ((1u << far) - 1);
+
+            if (hop) {
+
+                int near = __builtin_ctz(hop);
+                int from = hash_wrap(table, idx - far + near + table->capacity);
+
+                // Move the element forward to the empty cell
+                table->array[idx].data = table->array[from].data;
+                table->array[idx].hash = table->array[from].hash;
+                table->array[from].data = NULL;
+
+                owner->hop = (owner->hop & ~(1u << near)) | (1u << far);
+
+                idx = from;
+                distance -= far - near;
+                moved = true;
+            }
+        }
+
+        // If no element can move, the neighbourhood is full
+        if (not moved) return -1;
+    }
+
+    // Place data
+    table->array[idx].data = data;
+    table->array[idx].hash = hash;
+    table->array[home].hop |= 1u << distance;
+
+    return idx;
+}
+
+
+/**
+ * Try to place again the elements of the overflow in their neighbourhoods
+ * (after some deletes, there may be room for them)
+*/
+void hopscotch_drain(Hash table) {
+
+    // While there are elements in the overflow and empty cells in the table
+    for (int i = 0; i < table->overflowed and table->stuffed - table->overflowed < table->capacity; ) {
+
+        Cell cell = &table->overflow[i];
+
+        // If it fits now, move the last element of the overflow to its cell
+        if (hopscotch_place(table, cell->data, cell->hash) != -1) {
+
+            table->array[hash_index(table, cell->hash)].distance--;
+            *cell = table->overflow[--table->overflowed];
+        }
+
+        else i++;
+    }
+}
+
+
+/**
+ * Return the slot of given data, with its hash, in the hopscotch hash table
+ * (see hash_slot)
+*/
+void* *hopscotch_slot(Hash table, void* data, unsigned hash, int* found) {
+
+    // If data already exist in the table
+    Cell cell = hopscotch_search(table, data, hash);
+    *found = cell exist;
+    if (*found) return &cell->data;
+
+    // If there is no room for data, rehash
+    if (table->stuffed - table->overflowed == table->capacity) hash_rehash(table);
+
+    // Add data in its neighbourhood
+    int idx = hopscotch_place(table, data, hash);
+    if (idx != -1) {
+
+        table->stuffed++;
+        return &table->array[idx].data;
+    }
+
+    // If the overflow is full (and the table is more than half full, otherwise
+    // the hash is too weak for a rehash to help), make room in it
+    if (table->overflowed >= hopscotch_overflow_limit(table) and table->stuffed > table->capacity / 2) {
+
+        hopscotch_drain(table);
+
+        // If most of the overflow didnt fit, rehash and try again
+        if (table->overflowed > hopscotch_overflow_limit(table) / 2) {
+
+            hash_rehash(table);
+            return hopscotch_slot(table, data, hash, found);
+        }
+    }
+
+    // Add data to the overflow
+    return &hopscotch_overflow(table, data, hash, hash_index(table, hash))->data;
+}
+
+
+/**
+ * Take given data out of the hopscotch hash table (without destroy it)
+ * Return data of the table, or NULL if it isnt on it
+*/
+void* hopscotch_take(Hash table, void* data) {
+
+    unsigned hash = table->hash(data);
+
+    // If data doesnt exist in the table
+    Cell cell = hopscotch_search(table, data, hash);
+    if (not cell) return NULL;
+
+    int home = hash_index(table, hash);
+    void* taken = cell->data;
+    table->stuffed--;
+
+    // If data is in the overflow, move the last element of the overflow to its cell
+    if (cell >= table->overflow and cell < table->overflow + table->overflowed) {
+
+        *cell = table->overflow[--table->overflowed];
+        table->array[home].distance--;
+        return taken;
+    }
+
+    // Take data and clear its bit in the home cell
+    int idx = cell - table->array;
+    cell->data = NULL;
+    table->array[home].hop &= ~(1u << hash_wrap(table, idx - home + table->capacity));
+
+    // Move back to the free cell the furthest element that can go there, and so on
+    // with the cell it frees, so the elements stay close to their home cells
+    int range = hopscotch_range(table);
+    for (int moved = true; moved; ) {
+
+        moved = false;
+        int best = -1, bestOwner = -1, bestNear = -1;
+
+        // At each home cell whose neighbourhood has the free cell
+        for (int near = 0; near < range; near++) {
+
+            int owner = hash_wrap(table, idx - near + table->capacity);
+            unsigned hop = table->array[owner].hop >> near >> 1;
+
+            // Its furthest element after the free cell
+            if (hop) {
+
+                int far = near + 32 - __builtin_clz(hop);
+                int from = hash_wrap(table, owner + far);
+                int ahead = hash_wrap(table, from - idx + table->capacity);
+
+                if (ahead > best) { best = ahead; bestOwner = owner; bestNear = near; }
+            }
+        }
+
+        if (best > 0) {
+
+            int from = hash_wrap(table, idx + best);
+            table->array[idx].data = table->array[from].data;
+            table->array[idx].hash = table->array[from].hash;
+            table->array[from].data = NULL;
+            table->array[bestOwner].hop = (table->array[bestOwner].hop & ~(1u << (bestNear + best))) | (1u << bestNear);
+
+            idx = from;
+            moved = true;
+        }
+    }
+
+    return taken;
+}
+
+
 /**
  * Create an empty hash table
 */
@@ -49,21 +553,30 @@ Hash hash_create(int capacity, ProbingType type, FunctionCopy copy, FunctionDest
     Hash newTable = malloc(sizeof(struct _Hash));
 
     newTable->capacity = capacity;
+    newTable->minCapacity = capacity;
     newTable->stuffed = 0;
-    
-    // Ark memory for the array
-    newTable->array = malloc(sizeof(Cell) * newTable->capacity);
+    newTable->deleted = 0;
+    newTable->probes = 0;
+
+    newTable->overflow = NULL;
+    newTable->overflowed = 0;
+    newTable->overflowCapacity = 0;
+
+    // Ark memory for the array, the cells are stored in it
+    newTable->array = malloc(sizeof(struct _Cell) * newTable->capacity);
 
     // Initialize the array
     for (int i = 0; i < newTable->capacity; i++) {
 
-        // Ask memory for each cell
-        newTable->array[i] = malloc(sizeof(struct _Cell));
-        newTable->array[i]->data = NULL;
-        newTable->array[i]->deleted = false;
+        newTable->array[i].data = NULL;
+        newTable->array[i].deleted = false;
+        newTable->array[i].distance = 0;
+        newTable->array[i].hop = 0;
     }
 
     newTable->type = type;
+    newTable->maxLoad = OVERLOAD_CHARGE_FACTOR;
+    newTable->powerOfTwo = false;
 
     newTable->copy = copy;
     newTable->destroy = destroy;
@@ -86,18 +599,19 @@ void hash_destroy(Hash table) {
     for (int i = 0; i < table->capacity; i++) {
 
         // If data exist
-        if (table->array[i]->data exist) {
+        if (table->array[i].data exist) {
 
             // Delete data
-            table->destroy(table->array[i]->data);
+            table->destroy(table->array[i].data);
         }
-
-        // Free the cell
-        free(table->array[i]);
     }
+
+    // Delete the data of the overflow
+    for (int i = 0; i < table->overflowed; i++) table->destroy(table->overflow[i].data);
     
     // Free the array
     free(table->array);
+    free(table->overflow);
 
     // Free the table
     free(table);
@@ -117,26 +631,55 @@ int hash_stuffed(Hash table) { return table->stuffed; }
 
 
 /**
- * Search given data in the hash table
+ * Return the amount of deleted cells in the hash table
+ */
+int hash_deleted(Hash table) { return table->deleted; }
+
+
+/**
+ * Return the amount of cells probed by the last search, add or delete
+ */
+int hash_probes(Hash table) { return table->probes; }
+
+
+/**
+ * Search given data, with its hash, in the hash table
 */
-void* hash_search(Hash table, void* data) {
+void* hash_search_hashed(Hash table, void* data, unsigned hash) {
 
-    if (not table) return  NULL;
+    // Robin Hood has its own search
+    if (table->type == ROBIN_HOOD) {
+
+        int idx, distance;
+        return robin_hood_search(table, data, hash, &idx, &distance) ? table->array[idx].data : NULL;
+    }
+
+    // Hopscotch has its own search
+    if (table->type == HOPSCOTCH) {
+
+        Cell cell = hopscotch_search(table, data, hash);
+        return cell exist ? cell->data : NULL;
+    }
 
     // Calculate key of data
-    int idx = table->hash(data) % table->capacity;
+    int idx = hash_index(table, hash);
+
+    // Step of the probing (only used by double hashing, calculated on the second probe)
+    int step = 0;
 
     // Search data by probing
-    for (int limit = 0, i = 0;
-        limit < table->capacity and (table->array[idx]->deleted or
-        (table->array[idx]->data exist and table->compare(table->array[idx]->data, data) != 0));
-        limit++, idx = probing(idx, ++i, table->capacity, table->type));
+    table->probes = 1;
+    int limit = 0;
+    for (int i = 0;
+        limit < table->capacity and (table->array[idx].deleted or
+        (table->array[idx].data exist and not hash_match(table, idx, data, hash)));
+        limit++, table->probes++, idx = probing(table, idx, ++i, hash, &step));
 
     
-    // If data found
-    if (table->array[idx]->data exist and table->compare(table->array[idx]->data, data) == 0) {
+    // If data found (the probing stopped at a cell with data, so it matched and isnt compared again)
+    if (limit < table->capacity and table->array[idx].data exist) {
 
-        return table->array[idx]->data;
+        return table->array[idx].data;
     }
 
     // Data doesnt found
@@ -148,34 +691,92 @@ void* hash_search(Hash table, void* data) {
 
 
 /**
- * Search given data in the hash table 
+ * Search given data in the hash table
+*/
+void* hash_search(Hash table, void* data) {
+
+    if (not table) return  NULL;
+
+    return hash_search_hashed(table, data, table->hash(data));
+}
+
+
+/**
+ * Search the given amount of keys in the hash table, saving on out the data of each one (or NULL)
+ *
+ * The keys go in batches of SEARCH_BATCH: first their hashes are calculated and their
+ * home cells prefetched, then the data of the home cells with the same hash is prefetched,
+ * and at last each key is searched, so the cache misses of the batch overlap
+*/
+void hash_search_batch(Hash table, void* *keys, int n, void* *out) {
+
+    if (not table) return;
+
+    unsigned hashes[SEARCH_BATCH];
+    int idxs[SEARCH_BATCH];
+
+    for (int first = 0; first < n; first += SEARCH_BATCH) {
+
+        int size = n - first < SEARCH_BATCH ? n - first : SEARCH_BATCH;
+
+        // Hash each key and prefetch its home cell
+        for (int i = 0; i < size; i++) {
+
+            hashes[i] = table->hash(keys[first + i]);
+            idxs[i] = hash_index(table, hashes[i]);
+            __builtin_prefetch(&table->array[idxs[i]]);
+        }
+
+        // Prefetch the data of the home cells that may have the key
+        for (int i = 0; i < size; i++) {
+
+            Cell cell = &table->array[idxs[i]];
+            if (cell->data exist and cell->hash == hashes[i]) __builtin_prefetch(cell->data);
+        }
+
+        // Search each key (mostly in cache now)
+        for (int i = 0; i < size; i++) {
+
+            out[first + i] = hash_search_hashed(table, keys[first + i], hashes[i]);
+        }
+    }
+}
+
+
+/**
+ * Search given data, with its hash, in the hash table 
  * Return index of the table if found, 
- * otherwise return the index of the first free cell
+ * otherwise return the index of the first free cell (or -1 if there is none)
 */
-int hash_search_idx(Hash table, void* data) {
+int hash_search_idx(Hash table, void* data, unsigned hash) {
 
     if (not table) return -1;
 
     // Calculate key of data
-    int idx = table->hash(data) % table->capacity;
+    int idx = hash_index(table, hash);
+
+    // Step of the probing (only used by double hashing, calculated on the second probe)
+    int step = 0;
 
     // Save the index of the first deleted cell
     int first_deleted = idx;
 
     // Search data by probing
-    for (int limit = 0, i = 0;
-        limit < table->capacity and (table->array[idx]->deleted or
-        (table->array[idx]->data exist and table->compare(table->array[idx]->data, data) != 0));
-        limit++, idx = probing(idx, ++i, table->capacity, table->type)) {
-
-            if (table->array[first_deleted]->data exist and not table->array[idx]->data) {
+    table->probes = 1;
+    int limit = 0;
+    for (int i = 0;
+        limit < table->capacity and (table->array[idx].deleted or
+        (table->array[idx].data exist and not hash_match(table, idx, data, hash)));
+        limit++, table->probes++, idx = probing(table, idx, ++i, hash, &step)) {
+
+            if (table->array[first_deleted].data exist and not table->array[idx].data) {
                 first_deleted = idx;
             }
         }
 
     
-    // If data found
-    if (table->array[idx]->data exist and table->compare(table->array[idx]->data, data) == 0) {
+    // If data found (the probing stopped at a cell with data, so it matched and isnt compared again)
+    if (limit < table->capacity and table->array[idx].data exist) {
 
         // Return index of data
         return idx;
@@ -185,7 +786,7 @@ int hash_search_idx(Hash table, void* data) {
     else {
 
         // If there was some cell deleted
-        if (table->array[first_deleted]->deleted) {
+        if (table->array[first_deleted].deleted) {
 
             // Return the index of the first deleted cell
             return first_deleted;
@@ -195,127 +796,310 @@ int hash_search_idx(Hash table, void* data) {
         else {
 
             // Return the index of the first empty cell
-            return idx;
+            // If the probing went through the table without finding one, there is no room
+            return table->array[idx].data exist ? -1 : idx;
         }
     }
 } 
 
 
 /**
- * Add given data to the hash table
+ * Return the slot of given data, with its hash, in the hash table (see hash_slot)
 */
-void hash_add(Hash table, void* data) {
+void* *hash_slot_hashed(Hash table, void* data, unsigned hash, int* found) {
 
-    if (not table) return;
+    // Calculate the charge factor (with deleted cells) and evaluate if needs to rehash
+    // (all the probings but hopscotch need an empty cell to stop, so data cant take the last one)
+    if ((float) (table->stuffed + table->deleted) / (float) table->capacity > table->maxLoad or
+        (table->type != HOPSCOTCH and table->stuffed + table->deleted + 1 >= table->capacity)) {
 
-    // Calculate the charge factor and evaluate if needs to rehash
-    if ((float) table->stuffed / (float) table->capacity > OVERLOAD_CHARGE_FACTOR) {
+        // If most of them are deleted cells, rebuild at the same capacity to clean them
+        if (table->deleted > table->stuffed / 2)
+            hash_resize(table, table->capacity);
 
         // Rehash
-        hash_rehash(table);
+        else
+            hash_rehash(table);
+    }
+
+    // Robin Hood has its own add
+    if (table->type == ROBIN_HOOD) {
+
+        return robin_hood_slot(table, data, hash, found);
+    }
+
+    // Hopscotch has its own add
+    if (table->type == HOPSCOTCH) {
+
+        return hopscotch_slot(table, data, hash, found);
     }
 
     // Search index of data in the table
-    int idx = hash_search_idx(table, data);
+    int idx = hash_search_idx(table, data, hash);
+
+    // While there is no room for data, rehash and search again
+    // (cuadratic probing doesnt go through all the cells, so one rehash may not be enough)
+    while (idx == -1) {
+
+        hash_rehash(table);
+        idx = hash_search_idx(table, data, hash);
+    }
 
     // If data already exist in the table
-    if (table->array[idx]->data exist) {
+    *found = table->array[idx].data exist;
+    if (*found) return &table->array[idx].data;
 
-        // Destroy to replace without lose memory
-        table->destroy(table->array[idx]->data);
-        
-        // Replace data
-        table->array[idx]->data = table->copy(data);
-    }    
+    // If data takes a deleted cell
+    if (table->array[idx].deleted) table->deleted--;
+
+    // Add data
+    table->array[idx].data = data;
+    table->array[idx].hash = hash;
+    table->array[idx].deleted = false;
+    table->stuffed++;
+
+    return &table->array[idx].data;
+}
+
+
+/**
+ * Return the slot of given data in the hash table, and save on found if data was already on it
+ * If data isnt on the table, a slot is added for it with given data (without copy it),
+ * to replace by the caller with data equal to it
+*/
+void* *hash_slot(Hash table, void* data, int* found) {
+
+    if (not table) return NULL;
+
+    return hash_slot_hashed(table, data, table->hash(data), found);
+}
+
+
+/**
+ * Add given data to the hash table
+*/
+void hash_add(Hash table, void* data) {
+
+    if (not table) return;
+
+    int found;
+    void* *slot = hash_slot(table, data, &found);
+
+    // If data already exist in the table, destroy to replace without lose memory
+    if (found) table->destroy(*slot);
+
+    // Add data
+    *slot = table->copy(data);
+}
+
+
+/**
+ * Take given data out of the linear probing hash table (without destroy it)
+ * Return data of the table, or NULL if it isnt on it
+ *
+ * Instead of leaving a deleted cell, the next elements of the cluster are shifted back
+ * to the free cell when it is between them and their home cell, so a search
+ * can always stop at the first empty cell
+*/
+void* linear_take(Hash table, void* data) {
 
     // If data doesnt exist in the table
-    else {
+    int idx = hash_search_idx(table, data, table->hash(data));
+    if (idx == -1 or not table->array[idx].data) return NULL;
 
-        // Add data
-        table->array[idx]->data = table->copy(data);
-        table->array[idx]->deleted = false;
-        table->stuffed++;
+    // Take data
+    void* taken = table->array[idx].data;
+
+    // Shift back the next elements of the cluster whose home cell isnt after the free cell
+    // (at most the rest of the table, a full table has no empty cell to stop)
+    int next = hash_wrap(table, idx + 1);
+    for (int i = 1; i < table->capacity and table->array[next].data exist; i++, next = hash_wrap(table, next + 1)) {
+
+        int home = hash_index(table, table->array[next].hash);
+
+        if (hash_wrap(table, next - home + table->capacity) >= hash_wrap(table, next - idx + table->capacity)) {
+
+            table->array[idx].data = table->array[next].data;
+            table->array[idx].hash = table->array[next].hash;
+            idx = next;
+        }
     }
+
+    // The last cell shifted is free now
+    table->array[idx].data = NULL;
+    table->stuffed--;
+
+    return taken;
 }
 
 
 /**
- * Delete given data from the hash table
+ * Take given data out of the hash table (without destroy it)
+ * Return data of the table, or NULL if it isnt on it
 */
-void hash_delete(Hash table, void* data) {
+void* hash_take(Hash table, void* data) {
 
-    if (not table) return;
+    if (not table) return NULL;
 
-    // Search index of data in the table
-    int idx = hash_search_idx(table, data);
+    void* taken = NULL;
 
-    // If data already exist in the hash table
-    if (table->array[idx]->data exist) {
+    // Linear probing shifts back the cluster (without deleted cells)
+    if (table->type == LINEAR) {
 
-        // Delete data
-        table->destroy(table->array[idx]->data);
-        table->array[idx]->data = NULL;
-        table->array[idx]->deleted = true;
-        table->stuffed--;
-    }    
-} 
+        taken = linear_take(table, data);
+    }
+
+    // Robin Hood has its own take (without deleted cells)
+    else if (table->type == ROBIN_HOOD) {
+
+        taken = robin_hood_take(table, data);
+    }
+
+    // Hopscotch has its own take (without deleted cells)
+    else if (table->type == HOPSCOTCH) {
+
+        taken = hopscotch_take(table, data);
+    }
+
+    else {
+
+        // Search index of data in the table
+        int idx = hash_search_idx(table, data, table->hash(data));
+
+        // If data already exist in the hash table
+        if (idx != -1 and table->array[idx].data exist) {
+
+            // Take data
+            taken = table->array[idx].data;
+            table->array[idx].data = NULL;
+            table->array[idx].deleted = true;
+            table->stuffed--;
+            table->deleted++;
+        }
+    }
+
+    // Calculate the charge factor and evaluate if needs to shrink (not below the initial capacity)
+    if (table->capacity / 2 >= table->minCapacity and
+        (float) table->stuffed / (float) table->capacity < UNDERLOAD_CHARGE_FACTOR) {
+
+        hash_resize(table, table->capacity / 2);
+    }
+
+    return taken;
+}
 
 
 /**
- * Auxiliar "copy" function to rehash
- * (do not copy actually)
+ * Delete given data from the hash table
 */
-void* pointer(void* data) {
+void hash_delete(Hash table, void* data) {
 
-    return data;
+    if (not table) return;
+
+    void* taken = hash_take(table, data);
+
+    // If data was in the hash table
+    if (taken exist) table->destroy(taken);
 }
 
 
-void hash_rehash(Hash table) {
+/**
+ * Resize the hash table at the given capacity and rehash each of its elements
+ * (at the same capacity, it cleans the deleted cells)
+*/
+void hash_resize(Hash table, int capacity) {
 
     if (not table) return;
 
     // Auxiliar array to delete
-    Cell *oldArray = table->array;
+    Cell oldArray = table->array;
+    int oldCapacity = table->capacity;
+
+    // Auxiliar overflow to delete
+    Cell oldOverflow = table->overflow;
+    int oldOverflowed = table->overflowed;
+
+    table->overflow = NULL;
+    table->overflowed = 0;
+    table->overflowCapacity = 0;
 
     // Resize the array of the table
-    table->capacity *= 2 ;
+    table->capacity = capacity;
     table->stuffed = 0;
-    table->array = malloc(sizeof(Cell) * table->capacity);
+    table->deleted = 0;
+    table->array = malloc(sizeof(struct _Cell) * table->capacity);
 
     // Initialize the new array
     for (int i = 0; i < table->capacity; i++) {
 
-        // Ask memory for each cell
-        table->array[i] = malloc(sizeof(struct _Cell));
-        table->array[i]->data = NULL;
-        table->array[i]->deleted = false;
+        table->array[i].data = NULL;
+        table->array[i].deleted = false;
+        table->array[i].distance = 0;
+        table->array[i].hop = 0;
     }
 
-    // Save the copy function
-    FunctionCopy copy = table->copy;
-
-    table->copy = pointer;
-
-    // Rehash each element
-    for (int i = 0; i < table->capacity / 2; i++) {
+    // Rehash each element (with the hash saved in the cell, and without copy it)
+    for (int i = 0; i < oldCapacity; i++) {
 
         // If exist in the old array
-        if (oldArray[i]->data exist) {
+        if (oldArray[i].data exist) {
 
-            // Rehash
-            hash_add(table, oldArray[i]->data);
+            int found;
+            hash_slot_hashed(table, oldArray[i].data, oldArray[i].hash, &found);
         }
-
-        // Free old cell
-        free(oldArray[i]);
     }
 
-    // Get the copy function back
-    table->copy = copy;
+    // Rehash each element of the old overflow
+    for (int i = 0; i < oldOverflowed; i++) {
+
+        int found;
+        hash_slot_hashed(table, oldOverflow[i].data, oldOverflow[i].hash, &found);
+    }
 
     // Free old array
     free(oldArray);
+    free(oldOverflow);
+}
+
+
+/**
+ * Resize the hash table at double of its capacity and rehash each of its elements
+*/
+void hash_rehash(Hash table) {
+
+    if (not table) return;
+
+    hash_resize(table, table->capacity * 2);
+}
+
+
+/**
+ * Index with a mask of the mixed hash, with the capacity rounded up to a power of two,
+ * instead of the modulo of the hash (false to get back to the modulo)
+*/
+void hash_set_power_of_two(Hash table, int enable) {
+
+    if (not table) return;
+
+    table->powerOfTwo = enable;
+
+    if (enable) table->minCapacity = hash_round_capacity(table->minCapacity);
+
+    // Move all the elements to their index of the new mode
+    hash_resize(table, enable ? hash_round_capacity(table->capacity) : table->capacity);
+}
+
+
+/**
+ * Set the charge factor that makes the hash table rehash (between 0 and 1,
+ * only hopscotch can be full, the other probings need an empty cell to stop)
+*/
+void hash_set_max_load(Hash table, float maxLoad) {
+
+    if (not table or maxLoad <= 0 or maxLoad > 1) return;
+    if (maxLoad == 1 and table->type != HOPSCOTCH) return;
+
+    table->maxLoad = maxLoad;
 }
 
 
@@ -333,10 +1117,10 @@ void hash_print(Hash table) {
         printf("[%i]: ", i);
         
         // If data exist
-        if (table->array[i]->data exist) {
+        if (table->array[i].data exist) {
 
             // Print data
-            table->visit(table->array[i]->data);
+            table->visit(table->array[i].data);
         }
 
         // If doesnt exist
@@ -346,6 +1130,24 @@ void hash_print(Hash table) {
         }
 
         // Print the delete state of the cell
-        printf(" Deleted: %i\n", table->array[i]->deleted);
+        printf(" Deleted: %i", table->array[i].deleted);
+
+        // Print the neighbourhood of the cell
+        if (table->type == HOPSCOTCH) printf(" Hop: %08x", table->array[i].hop);
+
+        puts("");
+    }
+
+    // Print the overflow
+    if (table->overflowed > 0) {
+
+        printf("Overflow: ");
+        for (int i = 0; i < table->overflowed; i++) {
+
+            table->visit(table->overflow[i].data);
+            printf(" ");
+        }
+
+        puts("");
     }
 }
\ No newline at end of file
@@ -19,9 +19,11 @@
 */
 typedef enum {
 
-    LINEAR,
+    LINEAR, /* Deleting shifts back the rest of the cluster, so there are no deleted cells */
     CUADRATIC,
     DOUBLE_HASHING,
+    ROBIN_HOOD, /* Linear probing that keeps the distance of each element to its home cell */
+    HOPSCOTCH, /* Linear probing that keeps each element near its home cell, found by a bitmap */
     // RANDOM,
 
 } ProbingType;
@@ -33,7 +35,10 @@ typedef enum {
 typedef struct _Cell {
 
     void* data;
+    unsigned hash; /* Hash of data, to rehash and compare only data with the same hash */
     int deleted;
+    int distance; /* Distance to the home cell (for Robin Hood), or elements of this home cell in the overflow (for hopscotch) */
+    unsigned hop; /* Bit i on if the cell i places ahead has an element of this home cell (only for hopscotch) */
 
 } *Cell;
 
@@ -43,12 +48,21 @@ typedef struct _Cell {
 */
 typedef struct _Hash {
 
-    Cell *array;
+    Cell array; /* Cells stored contiguously */
 
     int capacity;
+    int minCapacity; /* Capacity given at creation, the table doesnt shrink below it */
     int stuffed;
+    int deleted; /* Deleted cells (not empty for the probing) */
+    int probes; /* Cells probed by the last operation */
+
+    Cell overflow; /* Elements that dont fit in their neighbourhood (only for hopscotch) */
+    int overflowed;
+    int overflowCapacity;
 
     ProbingType type;
+    float maxLoad; /* Charge factor to rehash, OVERLOAD_CHARGE_FACTOR by default */
+    int powerOfTwo; /* Capacity is a power of two, index with a mask of the mixed hash */
 
     FunctionCopy copy;
     FunctionDestroy destroy;
@@ -60,21 +74,45 @@ typedef struct _Hash {
 
 
 /**
- * Overload charge factor to decide when to rehash
+ * Default overload charge factor to decide when to rehash
 */
 #define OVERLOAD_CHARGE_FACTOR 0.75
 
 
+/**
+ * Underload charge factor to decide when to shrink
+*/
+#define UNDERLOAD_CHARGE_FACTOR 0.125
+
+
+/**
+ * Size of the neighbourhood of each home cell for hopscotch
+ * (an element is never further than HOP_RANGE - 1 cells from its home, except the ones in the overflow)
+*/
+#define HOP_RANGE 32
+
+
+/**
+ * Max amount of elements in the overflow of hopscotch before placing them again
+ * (and rehash if most of them dont fit): HOP_OVERFLOW, or one every HOP_OVERFLOW_CELLS cells in big tables
+ * (it keeps growing if the table is half empty, as with a hash that doesnt spread the elements)
+*/
+#define HOP_OVERFLOW 64
+#define HOP_OVERFLOW_CELLS 1024
+
+
+/**
+ * Amount of keys searched together by hash_search_batch
+*/
+#define SEARCH_BATCH 16
+
+
 /**
  * Constant primes to probing
 */
 #define C1 7
 #define C2 19
 
-// For double hashing, may take a prime lower than the table size
-// Also may be co-prime with the table size
-#define CO_PRIME 31
-
 
 /**
  * Create an empty hash table
@@ -100,18 +138,52 @@ int hash_capacity(Hash);
 int hash_stuffed(Hash);
 
 
+/**
+ * Return the amount of deleted cells in the hash table
+ */
+int hash_deleted(Hash);
+
+
+/**
+ * Return the amount of cells probed by the last search, add or delete
+ */
+int hash_probes(Hash);
+
+
 /**
  * Search given data in the hash table
 */
 void* hash_search(Hash, void*);
 
 
+/**
+ * Search the given amount of keys in the hash table, saving on out the data of each one (or NULL)
+ * The keys are hashed and their cells prefetched by batches, so the cache misses overlap
+*/
+void hash_search_batch(Hash, void**, int, void**);
+
+
 /**
  * Add given data to the hash table
 */
 void hash_add(Hash, void*);
 
 
+/**
+ * Return the slot of given data in the hash table, and save on found if data was already on it
+ * If data isnt on the table, a slot is added for it with given data (without copy it),
+ * to replace by the caller with data equal to it
+*/
+void* *hash_slot(Hash, void*, int*);
+
+
+/**
+ * Take given data out of the hash table (without destroy it)
+ * Return data of the table, or NULL if it isnt on it
+*/
+void* hash_take(Hash, void*);
+
+
 /**
  * Delete given data from the hash table
 */
@@ -124,6 +196,28 @@ void hash_delete(Hash, void*);
 void hash_rehash(Hash);
 
 
+/**
+ * Resize the hash table at the given capacity and rehash each of its elements
+ * (at the same capacity, it cleans the deleted cells)
+*/
+void hash_resize(Hash, int);
+
+
+/**
+ * Index with a mask of the mixed hash, with the capacity rounded up to a power of two,
+ * instead of the modulo of the hash (false to get back to the modulo)
+*/
+void hash_set_power_of_two(Hash, int);
+
+
+/**
+ * Set the charge factor that makes the hash table rehash (between 0 and 1, but only
+ * hopscotch takes 1: the other probings always keep an empty cell to stop)
+ * Robin Hood and hopscotch keep short probes up to 0.9 and more
+*/
+void hash_set_max_load(Hash, float);
+
+
 /**
  * Print the hash table
 */
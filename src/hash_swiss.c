@@ -0,0 +1,347 @@
+#include "hash_swiss.h"
+#include "mix.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+/**
+ * Hash table
+ *
+ * Closed hashing: group probing (Swiss table)
+*/
+
+
+/**
+ * Control byte of the mixed hash (hash_mix): its high 7 bits, the low ones choose the first group
+ * (they only overlap in tables of more than 2^25 cells, where the bytes filter a bit less)
+*/
+int8_t swiss_byte(unsigned mixed) { return mixed >> 25; }
+
+
+/**
+ * Return a mask with a bit on for each cell of the group starting at the
+ * given index whose control byte is equal to the given one
+*/
+unsigned swiss_match(int8_t *control, int idx, int8_t byte) {
+
+#ifdef __SSE2__
+
+    // Compare the 16 control bytes at once
+    __m128i group = _mm_loadu_si128((__m128i*) (control + idx));
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte)));
+
+#else
+
+    unsigned mask = 0;
+    for (int i = 0; i < SWISS_GROUP; i++) {
+
+        if (control[idx + i] == byte) mask |= 1u << i;
+    }
+    return mask;
+
+#endif
+}
+
+
+/**
+ * Return the index of the lowest bit on of the mask
+*/
+int swiss_first_bit(unsigned mask) {
+
+    return __builtin_ctz(mask);
+}
+
+
+/**
+ * Set the control byte of the cell, and its copy at the end if its in the first group
+*/
+void swiss_set_control(SwissHash table, int idx, int8_t byte) {
+
+    table->control[idx] = byte;
+
+    if (idx < SWISS_GROUP)
+        table->control[table->capacity + idx] = byte;
+}
+
+
+/**
+ * Ask memory for the control bytes and the cells of the given capacity, all empty
+*/
+void swiss_init(SwissHash table, int capacity) {
+
+    table->capacity = capacity;
+    table->stuffed = 0;
+    table->deleted = 0;
+
+    table->control = malloc(sizeof(int8_t) * (capacity + SWISS_GROUP));
+    table->array = malloc(sizeof(void*) * capacity);
+
+    for (int i = 0; i < capacity + SWISS_GROUP; i++) {
+
+        table->control[i] = SWISS_EMPTY;
+    }
+}
+
+
+/**
+ * Round up the capacity to a power of two, at least SWISS_GROUP
+*/
+int swiss_round_capacity(int capacity) {
+
+    int rounded = SWISS_GROUP;
+    while (rounded < capacity) rounded *= 2;
+
+    return rounded;
+}
+
+
+/**
+ * Create an empty Swiss hash table
+ * The capacity is rounded up to a power of two
+*/
+SwissHash swiss_create(int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash) {
+
+    // Ask memory for the hash table
+    SwissHash newTable = malloc(sizeof(struct _SwissHash));
+
+    swiss_init(newTable, swiss_round_capacity(capacity));
+
+    newTable->copy = copy;
+    newTable->destroy = destroy;
+    newTable->compare = compare;
+    newTable->visit = visit;
+    newTable->hash = hash;
+
+    return newTable;
+}
+
+
+/**
+ * Destroy the Swiss hash table
+*/
+void swiss_destroy(SwissHash table) {
+
+    if (not table) return;
+
+    // Iterate through the hash table
+    for (int i = 0; i < table->capacity; i++) {
+
+        // If data exist
+        if (table->control[i] >= 0) {
+
+            // Delete data
+            table->destroy(table->array[i]);
+        }
+    }
+
+    free(table->control);
+    free(table->array);
+    free(table);
+}
+
+
+/**
+ * Return the capacity of the Swiss hash table
+ */
+int swiss_capacity(SwissHash table) { return table->capacity; }
+
+
+/**
+ * Return the amount of stuffed cells in the Swiss hash table
+ */
+int swiss_stuffed(SwissHash table) { return table->stuffed; }
+
+
+/**
+ * Search given data in the Swiss hash table, return the index of its cell or -1
+*/
+int swiss_search_idx(SwissHash table, void* data, unsigned mixed) {
+
+    int mask = table->capacity - 1;
+    int8_t byte = swiss_byte(mixed);
+
+    // Go through the groups (the step grows by one group each time,
+    // so all the groups are visited since the capacity is a power of two)
+    int idx = mixed & mask;
+    for (int step = SWISS_GROUP; step <= table->capacity + SWISS_GROUP; step += SWISS_GROUP) {
+
+        // Cells whose control byte match
+        for (unsigned match = swiss_match(table->control, idx, byte); match; match &= match - 1) {
+
+            int cell = (idx + swiss_first_bit(match)) & mask;
+
+            if (table->compare(table->array[cell], data) == 0) return cell;
+        }
+
+        // If there is some empty cell in the group, data is not in the table
+        if (swiss_match(table->control, idx, SWISS_EMPTY)) return -1;
+
+        idx = (idx + step) & mask;
+    }
+
+    return -1;
+}
+
+
+/**
+ * Return the index of the first empty or deleted cell in the probing of the given hash
+*/
+int swiss_free_idx(SwissHash table, unsigned mixed) {
+
+    int mask = table->capacity - 1;
+
+    int idx = mixed & mask;
+    for (int step = SWISS_GROUP; ; step += SWISS_GROUP) {
+
+        // Empty and deleted control bytes are the negative ones
+        unsigned available = swiss_match(table->control, idx, SWISS_EMPTY) | swiss_match(table->control, idx, SWISS_DELETED);
+
+        if (available) return (idx + swiss_first_bit(available)) & mask;
+
+        idx = (idx + step) & mask;
+    }
+}
+
+
+/**
+ * Search given data in the Swiss hash table
+*/
+void* swiss_search(SwissHash table, void* data) {
+
+    if (not table) return NULL;
+
+    int idx = swiss_search_idx(table, data, hash_mix(table->hash(data)));
+
+    return idx == -1 ? NULL : table->array[idx];
+}
+
+
+/**
+ * Add given data to the Swiss hash table
+*/
+void swiss_add(SwissHash table, void* data) {
+
+    if (not table) return;
+
+    unsigned mixed = hash_mix(table->hash(data));
+    int idx = swiss_search_idx(table, data, mixed);
+
+    // If data already exist in the table
+    if (idx != -1) {
+
+        // Destroy to replace without lose memory
+        table->destroy(table->array[idx]);
+
+        // Replace data
+        table->array[idx] = table->copy(data);
+        return;
+    }
+
+    // Calculate the charge factor (with deleted cells) and evaluate if needs to rehash
+    if ((float) (table->stuffed + table->deleted + 1) / (float) table->capacity > SWISS_OVERLOAD_CHARGE_FACTOR) {
+
+        // If most of them are deleted cells, rehash at the same capacity to clean them
+        if (table->deleted > table->stuffed / 2)
+            swiss_rehash(table, table->capacity);
+
+        else
+            swiss_rehash(table, table->capacity * 2);
+    }
+
+    // Add data in the first free cell
+    idx = swiss_free_idx(table, mixed);
+
+    if (table->control[idx] == SWISS_DELETED) table->deleted--;
+
+    table->array[idx] = table->copy(data);
+    swiss_set_control(table, idx, swiss_byte(mixed));
+    table->stuffed++;
+}
+
+
+/**
+ * Delete given data from the Swiss hash table
+*/
+void swiss_delete(SwissHash table, void* data) {
+
+    if (not table) return;
+
+    int idx = swiss_search_idx(table, data, hash_mix(table->hash(data)));
+
+    // If data already exist in the table
+    if (idx != -1) {
+
+        table->destroy(table->array[idx]);
+        swiss_set_control(table, idx, SWISS_DELETED);
+
+        table->stuffed--;
+        table->deleted++;
+    }
+}
+
+
+/**
+ * Resize the Swiss hash table at the given capacity and rehash each of its elements
+*/
+void swiss_rehash(SwissHash table, int capacity) {
+
+    if (not table) return;
+
+    // Auxiliar arrays to delete
+    int8_t *oldControl = table->control;
+    void* *oldArray = table->array;
+    int oldCapacity = table->capacity;
+
+    swiss_init(table, swiss_round_capacity(capacity));
+
+    // Move each element (without copy it)
+    for (int i = 0; i < oldCapacity; i++) {
+
+        if (oldControl[i] >= 0) {
+
+            unsigned mixed = hash_mix(table->hash(oldArray[i]));
+            int idx = swiss_free_idx(table, mixed);
+
+            table->array[idx] = oldArray[i];
+            swiss_set_control(table, idx, swiss_byte(mixed));
+            table->stuffed++;
+        }
+    }
+
+    free(oldControl);
+    free(oldArray);
+}
+
+
+/**
+ * Print the Swiss hash table
+*/
+void swiss_print(SwissHash table) {
+
+    if (not table) return;
+
+    // Iterate through the hash table
+    for (int i = 0; i < table->capacity; i++) {
+
+        // At each cell
+        printf("[%i]: ", i);
+
+        // If data exist
+        if (table->control[i] >= 0) {
+
+            // Print data
+            table->visit(table->array[i]);
+        }
+
+        // If doesnt exist
+        else {
+
+            printf("NULL");
+        }
+
+        // Print the delete state of the cell
+        printf(" Deleted: %i\n", table->control[i] == SWISS_DELETED);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef __HASH_SWISS_H__
+#define __HASH_SWISS_H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "void.h"
+#include "sugar.h"
+
+
+/**
+ * Hash table
+ *
+ * Closed hashing: group probing (Swiss table)
+ *
+ * Beside the cells there is an array of control bytes, one for each cell,
+ * with 7 bits of the hash of its data (or if its empty or deleted).
+ * The probing goes through groups of SWISS_GROUP cells, comparing all their
+ * control bytes at once (SSE2 when available), and only calls compare on
+ * the cells whose 7 bits match.
+*/
+
+
+/**
+ * Amount of cells in a group
+*/
+#define SWISS_GROUP 16
+
+
+/**
+ * Control bytes of cells without data
+ * (the cells with data have the 7 bits of their hash, between 0 and 127)
+*/
+#define SWISS_EMPTY ((int8_t) -128)
+#define SWISS_DELETED ((int8_t) -2)
+
+
+/**
+ * Struct of the Swiss hash table
+*/
+typedef struct _SwissHash {
+
+    int8_t *control; /* capacity + SWISS_GROUP bytes, the first group is repeated at the end */
+    void* *array;
+
+    int capacity; /* Always a power of two, at least SWISS_GROUP */
+    int stuffed;
+    int deleted;
+
+    FunctionCopy copy;
+    FunctionDestroy destroy;
+    FunctionCompare compare;
+    FunctionVisit visit;
+    FunctionHash hash;
+
+} *SwissHash;
+
+
+/**
+ * Overload charge factor (stuffed and deleted cells) to decide when to rehash
+*/
+#define SWISS_OVERLOAD_CHARGE_FACTOR 0.875
+
+
+/**
+ * Create an empty Swiss hash table
+ * The capacity is rounded up to a power of two
+*/
+SwissHash swiss_create(int, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit, FunctionHash);
+
+
+/**
+ * Destroy the Swiss hash table
+*/
+void swiss_destroy(SwissHash);
+
+
+/**
+ * Return the capacity of the Swiss hash table
+ */
+int swiss_capacity(SwissHash);
+
+
+/**
+ * Return the amount of stuffed cells in the Swiss hash table
+ */
+int swiss_stuffed(SwissHash);
+
+
+/**
+ * Search given data in the Swiss hash table
+*/
+void* swiss_search(SwissHash, void*);
+
+
+/**
+ * Add given data to the Swiss hash table
+*/
+void swiss_add(SwissHash, void*);
+
+
+/**
+ * Delete given data from the Swiss hash table
+*/
+void swiss_delete(SwissHash, void*);
+
+
+/**
+ * Resize the Swiss hash table at the given capacity and rehash each of its elements
+*/
+void swiss_rehash(SwissHash, int);
+
+
+/**
+ * Print the Swiss hash table
+*/
+void swiss_print(SwissHash);
+
+
+#endif
\ No newline at end of file
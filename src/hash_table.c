@@ -0,0 +1,187 @@
+#include "hash_table.h"
+
+
+/**
+ * Hash table
+ *
+ * One interface to every hash table engine
+*/
+
+
+/**
+ * Functions of an engine that take its table as void*, to call them through TableOps
+ * (each one calls the function of the engine with the same name)
+*/
+#define TABLE_OPS(ops, prefix, Type) \
+    static void prefix##_destroy_op(void* table) { prefix##_destroy((Type) table); } \
+    static int prefix##_capacity_op(void* table) { return prefix##_capacity((Type) table); } \
+    static int prefix##_stuffed_op(void* table) { return prefix##_stuffed((Type) table); } \
+    static void* prefix##_search_op(void* table, void* data) { return prefix##_search((Type) table, data); } \
+    static void prefix##_add_op(void* table, void* data) { prefix##_add((Type) table, data); } \
+    static void prefix##_delete_op(void* table, void* data) { prefix##_delete((Type) table, data); } \
+    static void prefix##_print_op(void* table) { prefix##_print((Type) table); } \
+    \
+    static const TableOps ops = { \
+        prefix##_destroy_op, prefix##_capacity_op, prefix##_stuffed_op, prefix##_search_op, \
+        prefix##_add_op, prefix##_delete_op, prefix##_print_op, \
+    };
+
+
+/**
+ * Functions of each engine (the probing engines share them)
+*/
+TABLE_OPS(chainingOps, chaining, ChainingHash)
+TABLE_OPS(probingOps, hash, Hash)
+TABLE_OPS(swissOps, swiss, SwissHash)
+TABLE_OPS(cuckooOps, cuckoo, CuckooHash)
+
+
+/**
+ * Create an empty hash table of the given engine
+*/
+Table table_create(HashEngine engine, int capacity, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit, FunctionHash hash) {
+
+    // Ask memory for the hash table
+    Table newTable = malloc(sizeof(struct _Table));
+
+    newTable->engine = engine;
+
+    switch (engine) {
+
+        case ENGINE_CHAINING:
+            newTable->table = chaining_create(capacity, copy, destroy, compare, visit, hash);
+            newTable->ops = &chainingOps;
+            break;
+
+        case ENGINE_LINEAR:
+            newTable->table = hash_create(capacity, LINEAR, copy, destroy, compare, visit, hash);
+            newTable->ops = &probingOps;
+            break;
+
+        case ENGINE_CUADRATIC:
+            newTable->table = hash_create(capacity, CUADRATIC, copy, destroy, compare, visit, hash);
+            newTable->ops = &probingOps;
+            break;
+
+        case ENGINE_DOUBLE_HASHING:
+            newTable->table = hash_create(capacity, DOUBLE_HASHING, copy, destroy, compare, visit, hash);
+            newTable->ops = &probingOps;
+            break;
+
+        case ENGINE_ROBIN_HOOD:
+            newTable->table = hash_create(capacity, ROBIN_HOOD, copy, destroy, compare, visit, hash);
+            newTable->ops = &probingOps;
+            break;
+
+        case ENGINE_HOPSCOTCH:
+            newTable->table = hash_create(capacity, HOPSCOTCH, copy, destroy, compare, visit, hash);
+            newTable->ops = &probingOps;
+            break;
+
+        case ENGINE_SWISS:
+            newTable->table = swiss_create(capacity, copy, destroy, compare, visit, hash);
+            newTable->ops = &swissOps;
+            break;
+
+        case ENGINE_CUCKOO:
+            newTable->table = cuckoo_create(capacity, copy, destroy, compare, visit, hash);
+            newTable->ops = &cuckooOps;
+            break;
+
+        // None of the engines
+        default:
+            free(newTable);
+            return NULL;
+    }
+
+    return newTable;
+}
+
+
+/**
+ * Destroy the hash table
+*/
+void table_destroy(Table table) {
+
+    if (not table) return;
+
+    table->ops->destroy(table->table);
+    free(table);
+}
+
+
+/**
+ * Return the name of the engine
+*/
+const char* table_engine_name(HashEngine engine) {
+
+    const char* names[ENGINES] = {"CHAINING", "LINEAR", "CUADRATIC", "DOUBLE_HASHING", "ROBIN_HOOD", "HOPSCOTCH", "SWISS", "CUCKOO"};
+
+    return engine >= 0 and engine < ENGINES ? names[engine] : NULL;
+}
+
+
+/**
+ * Return the capacity of the hash table
+ */
+int table_capacity(Table table) {
+
+    if (not table) return 0;
+
+    return table->ops->capacity(table->table);
+}
+
+
+/**
+ * Return the amount of elements in the hash table
+ */
+int table_stuffed(Table table) {
+
+    if (not table) return 0;
+
+    return table->ops->stuffed(table->table);
+}
+
+
+/**
+ * Search given data in the hash table
+*/
+void* table_search(Table table, void* data) {
+
+    if (not table) return NULL;
+
+    return table->ops->search(table->table, data);
+}
+
+
+/**
+ * Add given data to the hash table
+*/
+void table_add(Table table, void* data) {
+
+    if (not table) return;
+
+    table->ops->add(table->table, data);
+}
+
+
+/**
+ * Delete given data from the hash table
+*/
+void table_delete(Table table, void* data) {
+
+    if (not table) return;
+
+    table->ops->delete(table->table, data);
+}
+
+
+/**
+ * Print the hash table
+*/
+void table_print(Table table) {
+
+    if (not table) return;
+
+    table->ops->print(table->table);
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef __HASH_TABLE_H__
+#define __HASH_TABLE_H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "void.h"
+#include "sugar.h"
+#include "hash_chaining.h"
+#include "hash_probing.h"
+#include "hash_swiss.h"
+#include "hash_cuckoo.h"
+
+
+/**
+ * Hash table
+ *
+ * One interface to every hash table engine, chosen at creation, so the same
+ * program can use (and compare) all of them
+ * (the concurrent ones return copies on search, so they arent here)
+*/
+
+
+/**
+ * Engine of the hash table
+*/
+typedef enum {
+
+    ENGINE_CHAINING,
+    ENGINE_LINEAR,
+    ENGINE_CUADRATIC,
+    ENGINE_DOUBLE_HASHING,
+    ENGINE_ROBIN_HOOD,
+    ENGINE_HOPSCOTCH,
+    ENGINE_SWISS,
+    ENGINE_CUCKOO,
+
+} HashEngine;
+
+
+/**
+ * Amount of engines
+*/
+#define ENGINES 8
+
+
+/**
+ * Functions of an engine, over its own table
+*/
+typedef struct _TableOps {
+
+    void (*destroy)(void*);
+    int (*capacity)(void*);
+    int (*stuffed)(void*);
+    void* (*search)(void*, void*);
+    void (*add)(void*, void*);
+    void (*delete)(void*, void*);
+    void (*print)(void*);
+
+} TableOps;
+
+
+/**
+ * Struct of the hash table
+*/
+typedef struct _Table {
+
+    void* table; /* Table of the engine */
+    const TableOps *ops;
+    HashEngine engine;
+
+} *Table;
+
+
+/**
+ * Create an empty hash table of the given engine
+*/
+Table table_create(HashEngine, int, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit, FunctionHash);
+
+
+/**
+ * Destroy the hash table
+*/
+void table_destroy(Table);
+
+
+/**
+ * Return the name of the engine
+*/
+const char* table_engine_name(HashEngine);
+
+
+/**
+ * Return the capacity of the hash table
+ */
+int table_capacity(Table);
+
+
+/**
+ * Return the amount of elements in the hash table
+ */
+int table_stuffed(Table);
+
+
+/**
+ * Search given data in the hash table
+*/
+void* table_search(Table, void*);
+
+
+/**
+ * Add given data to the hash table
+*/
+void table_add(Table, void*);
+
+
+/**
+ * Delete given data from the hash table
+*/
+void table_delete(Table, void*);
+
+
+/**
+ * Print the hash table
+*/
+void table_print(Table);
+
+
+#endif
\ No newline at end of file
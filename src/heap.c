@@ -5,13 +5,31 @@
  * Create an empty binary heap
 */
 BHeap bheap_create(int capacity, PriorityType type, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit) {
-    
+
+    return bheap_create_arity(capacity, 2, type, copy, destroy, compare, visit);
+}
+
+
+/**
+ * Create an empty heap where each father has the given amount of childs
+*/
+BHeap bheap_create_arity(int capacity, int arity, PriorityType type, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit) {
+
+    if (arity < 2) return NULL;
+
     // Ask for memory to create the heap
     BHeap newHeap = malloc(sizeof(struct _BHeap));
     newHeap->array = malloc(sizeof(void*) * (capacity + 1)); // +1 because heap[0] == NULL
 
     newHeap->capacity = capacity;
     newHeap->last = 0;
+    newHeap->arity = arity;
+
+    // Without handles
+    newHeap->handles = NULL;
+    newHeap->positions = NULL;
+    newHeap->generations = NULL;
+    newHeap->handlesUsed = 0;
 
     newHeap->type = type;
     
@@ -24,6 +42,23 @@ BHeap bheap_create(int capacity, PriorityType type, FunctionCopy copy, FunctionD
 }
 
 
+/**
+ * Create an empty heap where each father has the given amount of childs, that gives
+ * a handle to each element added, to update or delete it later
+*/
+BHeap bheap_create_handles(int capacity, int arity, PriorityType type, FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compare, FunctionVisit visit) {
+
+    BHeap newHeap = bheap_create_arity(capacity, arity, type, copy, destroy, compare, visit);
+    if (not newHeap) return NULL;
+
+    newHeap->handles = malloc(sizeof(int) * (capacity + 1));
+    newHeap->positions = malloc(sizeof(int) * (capacity + 1));
+    newHeap->generations = malloc(sizeof(unsigned) * (capacity + 1));
+
+    return newHeap;
+}
+
+
 /**
  * Destroy the binary heap
 */
@@ -36,6 +71,9 @@ void bheap_destroy(BHeap heap) {
         heap->destroy(heap->array[i]);
     }
     free(heap->array);
+    free(heap->handles);
+    free(heap->positions);
+    free(heap->generations);
     free(heap);
 }
 
@@ -60,6 +98,45 @@ int bheap_comparation(BHeap heap, void* a, void* b) {
 }
 
 
+/**
+ * Swap the elements at the given indexes of the binary heap, with their handles (if it has)
+*/
+void bheap_swap(BHeap heap, int i, int j) {
+
+    void* aux = heap->array[i];
+    heap->array[i] = heap->array[j];
+    heap->array[j] = aux;
+
+    if (not heap->handles) return;
+
+    int handle = heap->handles[i];
+    heap->handles[i] = heap->handles[j];
+    heap->handles[j] = handle;
+
+    heap->positions[heap->handles[i]] = i;
+    heap->positions[heap->handles[j]] = j;
+}
+
+
+/**
+ * Return the index of the father of the element at the given index
+*/
+int bheap_father(BHeap heap, int index) {
+
+    return (index - 2) / heap->arity + 1;
+}
+
+
+/**
+ * Return the index of the first child of the element at the given index
+ * (the childs of a father are next to each other)
+*/
+int bheap_child(BHeap heap, int index) {
+
+    return heap->arity * (index - 1) + 2;
+}
+
+
 /**
  * Check if the binary heap is empty, return true if its, false otherwise
 */
@@ -71,6 +148,17 @@ int bheap_is_empty(BHeap heap) {
 }
 
 
+/**
+ * Return the top of the binary heap, or NULL if its empty
+*/
+void* bheap_top(BHeap heap) {
+
+    if (not heap or heap->last == 0) return NULL;
+
+    return heap->array[1];
+}
+
+
 /**
  * Print the binary heap
 */
@@ -91,17 +179,14 @@ void bheap_print(BHeap heap) {
 */
 int bheap_climb(BHeap heap, int index) {
 
-    void* aux;
     int swapHappend = false;
 
     // While its not at the top, and can climb up
-    for (; index > 1 and bheap_comparation(heap, heap->array[index], heap->array[index/2]) > 0
-        ; index = index/2) {
+    for (; index > 1 and bheap_comparation(heap, heap->array[index], heap->array[bheap_father(heap, index)]) > 0
+        ; index = bheap_father(heap, index)) {
 
         // Swap the child with the father
-        aux = heap->array[index];
-        heap->array[index] = heap->array[index/2];
-        heap->array[index/2] = aux;
+        bheap_swap(heap, index, bheap_father(heap, index));
 
         // At least one swap happend
         swapHappend = true;
@@ -112,17 +197,121 @@ int bheap_climb(BHeap heap, int index) {
 
 
 /**
- * Insert the given data in the binary heap
+ * Resize the array of the binary heap to the given capacity
+*/
+void bheap_resize(BHeap heap, int capacity) {
+
+    heap->capacity = capacity;
+    heap->array = realloc(heap->array, sizeof(void*) * (capacity + 1)); // +1 because heap[0] == NULL
+
+    if (not heap->handles) return;
+
+    // Keep room for all the handles given, they are still valid
+    int handles = capacity > heap->handlesUsed ? capacity : heap->handlesUsed;
+    heap->handles = realloc(heap->handles, sizeof(int) * (handles + 1));
+    heap->positions = realloc(heap->positions, sizeof(int) * (handles + 1));
+    heap->generations = realloc(heap->generations, sizeof(unsigned) * (handles + 1));
+}
+
+
+/**
+ * Make room for the given amount of elements, doubling the capacity at least,
+ * so adding one by one takes amortized constant time
+*/
+void bheap_grow(BHeap heap, int amount) {
+
+    if (amount <= heap->capacity) return;
+
+    bheap_resize(heap, amount > heap->capacity * 2 ? amount : heap->capacity * 2);
+}
+
+
+/**
+ * Make room in the binary heap for the given amount of elements
+*/
+void bheap_reserve(BHeap heap, int capacity) {
+
+    if (not heap or capacity <= heap->capacity) return;
+
+    bheap_resize(heap, capacity);
+}
+
+
+/**
+ * Free the room of the binary heap that its elements dont use
 */
-void bheap_add(BHeap heap, void* data) {
+void bheap_shrink_to_fit(BHeap heap) {
 
     if (not heap) return;
 
+    bheap_resize(heap, heap->last);
+}
+
+
+/**
+ * Put the given data (without copy it) in the last position of the binary heap
+ * (that must have room), return its handle (0 if the heap doesnt give handles)
+ *
+ * A handle is the slot of the element in positions, with the generation of the slot
+ * in the high bits. The slots of the deleted elements stay after the last position,
+ * to give them again with the next generation
+*/
+BHandle bheap_append(BHeap heap, void* data) {
+
+    heap->array[++heap->last] = data;
+
+    if (not heap->handles) return 0;
+
+    // If there are no slots to give again, make a new one
+    if (heap->last > heap->handlesUsed) {
+
+        heap->handles[heap->last] = ++heap->handlesUsed;
+        heap->generations[heap->handlesUsed] = 0;
+    }
+
+    int slot = heap->handles[heap->last];
+    heap->positions[slot] = heap->last;
+
+    return (BHandle) heap->generations[slot] << 32 | slot;
+}
+
+
+/**
+ * Return the index of the element of the given handle in the binary heap,
+ * or 0 if it was deleted (or the heap doesnt give handles)
+*/
+int bheap_handle_index(BHeap heap, BHandle handle) {
+
+    if (not heap or not heap->handles) return 0;
+
+    long long slot = handle & 0xffffffff;
+    if (slot < 1 or slot > heap->handlesUsed) return 0;
+
+    // A handle of an element deleted is of an older generation than its slot
+    if (heap->generations[slot] != (unsigned) (handle >> 32)) return 0;
+
+    return heap->positions[slot];
+}
+
+
+/**
+ * Insert the given data in the binary heap, return its handle (0 if the heap doesnt give handles)
+ * (the array grows by doubling when the heap is full)
+*/
+BHandle bheap_add(BHeap heap, void* data) {
+
+    if (not heap) return 0;
+
+    // If the heap is full, ask for more memory
+    bheap_grow(heap, heap->last + 1);
+
     // Put the element in the last position
-    heap->array[++heap->last] = heap->copy(data);
+    BHandle handle = bheap_append(heap, heap->copy(data));
 
     // Let climb the last element
     bheap_climb(heap, heap->last);
+
+    return handle;
 }
 
 
@@ -134,17 +323,17 @@ int bheap_fall(BHeap heap, int index) {
     
     if (not heap) return 0;
 
-    void* aux;
-    int k, canFall = true, swapHappend = false;
+    int k, c, first, end, canFall = true, swapHappend = false;
 
     // While the childs exist and can keep falling
-    while (2 * index <= heap->last and canFall) {
-        
-        k = 2 * index;
+    while ((first = bheap_child(heap, index)) <= heap->last and canFall) {
+
+        end = first + heap->arity - 1 < heap->last ? first + heap->arity - 1 : heap->last;
 
-        // Choose the best child (lower or greater depends on priority)
-        if (k + 1 <= heap->last and bheap_comparation(heap, heap->array[k+1], heap->array[k]) > 0)
-            k++;
+        // Choose the best child among all of them, they are contiguous (lower or greater depends on priority)
+        for (k = first, c = first + 1; c <= end; c++) {
+            if (bheap_comparation(heap, heap->array[c], heap->array[k]) > 0) k = c;
+        }
 
         // If cant fall anymore
         if (bheap_comparation(heap, heap->array[index], heap->array[k]) > 0) {
@@ -154,9 +343,7 @@ int bheap_fall(BHeap heap, int index) {
         // Otherwise swap the father with the best child
         else {
             
-            aux = heap->array[index];
-            heap->array[index] = heap->array[k];
-            heap->array[k] = aux;
+            bheap_swap(heap, index, k);
             index = k;
 
             // At least one swap happend
@@ -168,19 +355,38 @@ int bheap_fall(BHeap heap, int index) {
 }
 
 
+/**
+ * Delete the element at the given index of the binary heap
+*/
+void bheap_remove(BHeap heap, int index) {
+
+    // Destroy the element and put the last one in place
+    heap->destroy(heap->array[index]);
+    bheap_swap(heap, index, heap->last);
+
+    // Its handle is no longer valid, the next one of its slot is of a new generation
+    if (heap->handles) {
+
+        int slot = heap->handles[heap->last];
+        heap->positions[slot] = 0;
+        heap->generations[slot]++;
+    }
+    heap->last--;
+
+    // Let climb or fall the element put in place
+    if (index <= heap->last and not bheap_climb(heap, index)) bheap_fall(heap, index);
+}
+
+
 /**
  * Delete the top of the binary heap
 */
 void bheap_pop(BHeap heap) {
     
-    if (not heap) return;
-
-    // Destroy the top and put the last element in place
-    heap->destroy(heap->array[1]);
-    heap->array[1] = heap->array[heap->last--];
+    if (not heap or heap->last == 0) return;
 
-    // Let fall the top of the heap
-    bheap_fall(heap, 1);
+    // Delete the top and let fall the element put in place
+    bheap_remove(heap, 1);
 }
 
 
@@ -192,30 +398,101 @@ void bheap_delete(BHeap heap, void* data) {
     if (not heap) return;
 
     // Search data in the heap
-    int i = 1, found = false;
-    for (; i <= heap->last and not found ; i++) {
+    for (int i = 1; i <= heap->last; i++) {
         
+        // If it was found, delete it
         if (heap->compare(heap->array[i], data) == 0) {
 
-            // Data found, save the index
-            found = true;
-            i--;
+            bheap_remove(heap, i);
+            return;
         }
     }
+}
 
-    // If it was found
-    if (found) {
 
-        // Delete the data
-        heap->destroy(heap->array[i]);
+/**
+ * Return the data of the given handle in the binary heap, or NULL if it was deleted
+*/
+void* bheap_get(BHeap heap, BHandle handle) {
 
-        // Replace it with the last element
-        heap->array[i] = heap->array[heap->last];
-        heap->last--;
+    int index = bheap_handle_index(heap, handle);
 
-        // Let fall that element
-        bheap_fall(heap, i);
+    return index ? heap->array[index] : NULL;
+}
+
+
+/**
+ * Replace the data of the given handle in the binary heap with a copy of
+ * the given data, and move it to its place for its new priority
+*/
+void bheap_update_priority(BHeap heap, BHandle handle, void* data) {
+
+    int index = bheap_handle_index(heap, handle);
+    if (not index) return;
+
+    // Replace data
+    heap->destroy(heap->array[index]);
+    heap->array[index] = heap->copy(data);
+
+    // Let climb or fall the element
+    if (not bheap_climb(heap, index)) bheap_fall(heap, index);
+}
+
+
+/**
+ * Delete the data of the given handle from the binary heap
+*/
+void bheap_delete_handle(BHeap heap, BHandle handle) {
+
+    int index = bheap_handle_index(heap, handle);
+    if (not index) return;
+
+    bheap_remove(heap, index);
+}
+
+
+/**
+ * Build the heap order in the whole array, letting fall each father
+ * from the last one up to the top (Floyd), in linear time
+*/
+void bheap_heapify(BHeap heap) {
+
+    for (int i = bheap_father(heap, heap->last); i >= 1; i--) bheap_fall(heap, i);
+}
+
+
+/**
+ * Insert copies of the given amount of data in the binary heap, saving the handle
+ * of each one on handles (if its not NULL)
+ * If there are as many as the elements of the heap, they are put at the end
+ * and the whole heap is rebuilt at once, otherwise each one climbs
+*/
+void bheap_add_many(BHeap heap, void* *array, int length, BHandle *handles) {
+
+    if (not heap or not array) return;
+
+    // Ask for more memory if needed
+    bheap_grow(heap, heap->last + length);
+
+    // If the batch is small, let climb each element
+    if (length < heap->last) {
+
+        for (int i = 0; i < length; i++) {
+
+            BHandle handle = bheap_add(heap, array[i]);
+            if (handles) handles[i] = handle;
+        }
+        return;
+    }
+
+    // Otherwise put all of them at the end and rebuild the heap (the handles follow the swaps)
+    for (int i = 0; i < length; i++) {
+
+        BHandle handle = bheap_append(heap, heap->copy(array[i]));
+        if (handles) handles[i] = handle;
     }
+
+    bheap_heapify(heap);
 }
 
 
@@ -230,16 +507,10 @@ BHeap bheap_create_from_array(void* *array, int length, PriorityType type, Funct
 
     // Make a copy of the given array
     heap->array[0] = NULL;
-    int i = 0;
-    for (; i < length; i++) heap->array[i+1] = copy(array[i]);
-
-    // Try to go up with all the nodes
-    while(i > 1) {
+    for (int i = 0; i < length; i++) bheap_append(heap, copy(array[i]));
 
-        // When the index cant climb anymore
-        if (not bheap_climb(heap, i))
-            i--;
-    }
+    // Let fall each father, from the bottom up
+    bheap_heapify(heap);
 
     return heap;
-}
+}
\ No newline at end of file
@@ -17,8 +17,18 @@ typedef enum {
 } PriorityType;
 
 
+/**
+ * Handle of an element of the heap, to update or delete it later
+ * (0 is no handle, and the handle of a deleted element is never valid again)
+*/
+typedef long long BHandle;
+
+
 /**
  * Binary heap
+ *
+ * Each father may have more than two childs (d-ary heap), so the tree is
+ * shallower and the childs compared on each fall are contiguous in memory
 */
 typedef struct _BHeap {
 
@@ -26,6 +36,13 @@ typedef struct _BHeap {
   int capacity;
   int last;
 
+  int *handles; /* Slot of the handle of the element at each index (and after the last, the slots to give again), NULL without handles */
+  int *positions; /* Index of the element of each slot, 0 if it was deleted */
+  unsigned *generations; /* Times each slot was given, to tell apart its handles */
+  int handlesUsed; /* Amount of slots given */
+
+  int arity; /* Amount of childs of each father (2 in a binary heap) */
+
   PriorityType type;
 
   FunctionCopy copy;
@@ -42,6 +59,21 @@ typedef struct _BHeap {
 BHeap bheap_create(int, PriorityType, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit);
 
 
+/**
+ * Create an empty heap where each father has the given amount of childs (2, 4 or 8
+ * fit better in cache lines), return NULL if its less than 2
+*/
+BHeap bheap_create_arity(int, int, PriorityType, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit);
+
+
+/**
+ * Create an empty heap where each father has the given amount of childs, that gives
+ * a handle to each element added, to update or delete it later
+ * (the other heaps dont keep the handles, so they dont pay for them)
+*/
+BHeap bheap_create_handles(int, int, PriorityType, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit);
+
+
 /**
  * Destroy the binary heap
 */
@@ -54,6 +86,12 @@ void bheap_destroy(BHeap);
 int bheap_is_empty(BHeap);
 
 
+/**
+ * Return the top of the binary heap, or NULL if its empty
+*/
+void* bheap_top(BHeap);
+
+
 /**
  * Print the binary heap
 */
@@ -68,9 +106,11 @@ int bheap_climb(BHeap, int);
 
 
 /**
- * Insert the given data in the binary heap
+ * Insert the given data in the binary heap, return its handle (0 if the heap doesnt give handles)
+ * The handle is valid till data is deleted
+ * (the array grows by doubling when the heap is full)
 */
-void bheap_add(BHeap, void*);
+BHandle bheap_add(BHeap, void*);
 
 
 /**
@@ -87,13 +127,52 @@ void bheap_pop(BHeap);
 
 
 /**
- * Delete data from the binary heap
+ * Delete data from the binary heap (searching it, in linear time)
 */
 void bheap_delete(BHeap, void*);
 
 
 /**
- * Return a binary heap created from the given array
+ * Return the data of the given handle in the binary heap, or NULL if it was deleted
+*/
+void* bheap_get(BHeap, BHandle);
+
+
+/**
+ * Replace the data of the given handle in the binary heap with a copy of
+ * the given data, and move it to its place for its new priority (in logarithmic time)
+*/
+void bheap_update_priority(BHeap, BHandle, void*);
+
+
+/**
+ * Delete the data of the given handle from the binary heap (in logarithmic time)
+*/
+void bheap_delete_handle(BHeap, BHandle);
+
+
+/**
+ * Insert copies of the given amount of data in the binary heap, saving the handle
+ * of each one on the given array (if its not NULL, and 0 if the heap doesnt give handles)
+ * (a big batch is put at the end and the heap is rebuilt in linear time)
+*/
+void bheap_add_many(BHeap, void**, int, BHandle*);
+
+
+/**
+ * Make room in the binary heap for the given amount of elements
+*/
+void bheap_reserve(BHeap, int);
+
+
+/**
+ * Free the room of the binary heap that its elements dont use
+*/
+void bheap_shrink_to_fit(BHeap);
+
+
+/**
+ * Return a binary heap created from the given array (in linear time)
 */
 BHeap bheap_create_from_array(void**, int, PriorityType, FunctionCopy, FunctionDestroy, FunctionCompare, FunctionVisit);
 
@@ -0,0 +1,234 @@
+#include "heap_key.h"
+#include <string.h>
+
+
+/**
+ * Heap of keys
+ *
+ * Numeric keys and payloads kept in the array, compared without calls
+*/
+
+
+/**
+ * Size of a cache line, in bytes
+*/
+#define KHEAP_LINE 64
+
+
+/**
+ * Entries before the top, so the childs of each father start a cache line
+ * (the childs of i start at KHEAP_ARITY * i + 1)
+*/
+#define KHEAP_OFFSET (KHEAP_LINE / sizeof(KEntry) - 1)
+
+
+/**
+ * Move the array of the heap of keys to a new block for the given capacity
+ * (realloc would lose the alignment)
+*/
+void kheap_resize(KHeap heap, int capacity) {
+
+    size_t bytes = sizeof(KEntry) * (KHEAP_OFFSET + capacity);
+    bytes = (bytes + KHEAP_LINE - 1) / KHEAP_LINE * KHEAP_LINE; // aligned_alloc needs a multiple of the alignment
+
+    KEntry* block = aligned_alloc(KHEAP_LINE, bytes);
+
+    if (heap->block) {
+        memcpy(block + KHEAP_OFFSET, heap->array, sizeof(KEntry) * heap->last);
+        free(heap->block);
+    }
+
+    heap->block = block;
+    heap->array = block + KHEAP_OFFSET;
+    heap->capacity = capacity;
+}
+
+
+/**
+ * Create an empty heap of keys
+*/
+KHeap kheap_create(int capacity, PriorityType type) {
+
+    // Ask for memory to create the heap
+    KHeap newHeap = malloc(sizeof(struct _KHeap));
+
+    newHeap->block = NULL;
+    newHeap->last = 0;
+    kheap_resize(newHeap, capacity > 0 ? capacity : 1);
+
+    newHeap->type = type;
+    newHeap->flip = type == MAX ? UINT64_MAX : 0;
+
+    return newHeap;
+}
+
+
+/**
+ * Destroy the heap of keys (not its payloads)
+*/
+void kheap_destroy(KHeap heap) {
+
+    if (not heap) return;
+
+    free(heap->block);
+    free(heap);
+}
+
+
+/**
+ * Check if the heap of keys is empty, return true if its, false otherwise
+*/
+int kheap_is_empty(KHeap heap) {
+
+    if (not heap) return false;
+
+    return (heap->last == 0 ? true : false);
+}
+
+
+/**
+ * Return the amount of entries of the heap of keys
+*/
+int kheap_size(KHeap heap) { return heap ? heap->last : 0; }
+
+
+/**
+ * Map the bits of a double to an integer in the same order
+ * (negatives are inverted, positives get the sign bit)
+*/
+uint64_t kheap_from_double(double key) {
+
+    uint64_t bits;
+    memcpy(&bits, &key, sizeof(bits));
+
+    return bits >> 63 ? ~bits : bits | (1ull << 63);
+}
+
+
+/**
+ * Map back an integer made by kheap_from_double to its double
+*/
+double kheap_to_double(uint64_t bits) {
+
+    bits = bits >> 63 ? bits & ~(1ull << 63) : ~bits;
+
+    double key;
+    memcpy(&key, &bits, sizeof(key));
+
+    return key;
+}
+
+
+/**
+ * Insert the payload with the given integer key in the heap of keys
+ * (the array grows by doubling when the heap is full)
+*/
+void kheap_add(KHeap heap, uint64_t key, void* payload) {
+
+    if (not heap) return;
+
+    // If the heap is full, ask for more memory
+    if (heap->last == heap->capacity) kheap_resize(heap, heap->capacity * 2);
+
+    KEntry entry = {key ^ heap->flip, payload};
+    int index = heap->last++;
+
+    // Move down the fathers with greater key, and put the entry in the hole left
+    while (index > 0 and entry.key < heap->array[(index - 1) / KHEAP_ARITY].key) {
+
+        heap->array[index] = heap->array[(index - 1) / KHEAP_ARITY];
+        index = (index - 1) / KHEAP_ARITY;
+    }
+
+    heap->array[index] = entry;
+}
+
+
+/**
+ * Insert the payload with the given double key in the heap of keys
+*/
+void kheap_add_double(KHeap heap, double key, void* payload) {
+
+    kheap_add(heap, kheap_from_double(key), payload);
+}
+
+
+/**
+ * Return the payload of the top of the heap of keys, or NULL if its empty
+*/
+void* kheap_top(KHeap heap) {
+
+    if (not heap or heap->last == 0) return NULL;
+
+    return heap->array[0].payload;
+}
+
+
+/**
+ * Return the integer key of the top of the heap of keys (0 if its empty)
+*/
+uint64_t kheap_top_key(KHeap heap) {
+
+    if (not heap or heap->last == 0) return 0;
+
+    return heap->array[0].key ^ heap->flip;
+}
+
+
+/**
+ * Return the double key of the top of the heap of keys (0 if its empty)
+*/
+double kheap_top_key_double(KHeap heap) {
+
+    if (not heap or heap->last == 0) return 0;
+
+    return kheap_to_double(heap->array[0].key ^ heap->flip);
+}
+
+
+/**
+ * Delete the top of the heap of keys
+*/
+void kheap_pop(KHeap heap) {
+
+    if (not heap or heap->last == 0) return;
+
+    // The last entry falls from the top
+    KEntry entry = heap->array[--heap->last];
+    int index = 0, first, end, k;
+
+    // While the childs exist
+    while ((first = KHEAP_ARITY * index + 1) < heap->last) {
+
+        end = first + KHEAP_ARITY < heap->last ? first + KHEAP_ARITY : heap->last;
+
+        // Choose the child with the lowest key, all of them are in the same cache line
+        k = first;
+        for (int c = first + 1; c < end; c++) {
+            if (heap->array[c].key < heap->array[k].key) k = c;
+        }
+
+        // If cant fall anymore
+        if (entry.key <= heap->array[k].key) break;
+
+        // Otherwise move up the child, and fall to its hole
+        heap->array[index] = heap->array[k];
+        index = k;
+    }
+
+    heap->array[index] = entry;
+}
+
+
+/**
+ * Print the integer keys of the heap of keys
+*/
+void kheap_print(KHeap heap) {
+
+    if (not heap) return;
+
+    for (int i = 0; i < heap->last; i++) {
+
+        printf("%llu ", (unsigned long long) (heap->array[i].key ^ heap->flip));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef __HEAP_KEY_H__
+#define __HEAP_KEY_H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "heap.h"
+
+
+/**
+ * Heap of keys
+ *
+ * Each entry is a numeric key with a payload, both kept in the array, so the
+ * entries are compared by their keys without calling compare nor following pointers.
+ *
+ * The keys are saved in a form where the top is always the lowest one: the double
+ * keys are mapped to integers in the same order, and in a MAX heap their bits are inverted.
+ * All the keys of a heap must be integers, or all doubles.
+ *
+ * Each father has KHEAP_ARITY childs, and the array is placed so the childs
+ * of each father fill one cache line.
+*/
+
+
+/**
+ * Amount of childs of each father (KHEAP_ARITY entries fill a cache line)
+*/
+#define KHEAP_ARITY 4
+
+
+/**
+ * Entry of the heap of keys
+*/
+typedef struct {
+
+    uint64_t key; /* Key in the saved form (lower is closer to the top) */
+    void* payload; /* Not owned by the heap */
+
+} KEntry;
+
+
+/**
+ * Struct of the heap of keys
+*/
+typedef struct _KHeap {
+
+    KEntry *array; /* Top at index 0, childs of i from KHEAP_ARITY * i + 1 */
+    KEntry *block; /* Memory of the array, aligned to a cache line */
+
+    int capacity;
+    int last; /* Amount of entries */
+
+    uint64_t flip; /* Bits to invert on the keys, all of them in a MAX heap */
+    PriorityType type;
+
+} *KHeap;
+
+
+/**
+ * Create an empty heap of keys
+*/
+KHeap kheap_create(int, PriorityType);
+
+
+/**
+ * Destroy the heap of keys (not its payloads)
+*/
+void kheap_destroy(KHeap);
+
+
+/**
+ * Check if the heap of keys is empty, return true if its, false otherwise
+*/
+int kheap_is_empty(KHeap);
+
+
+/**
+ * Return the amount of entries of the heap of keys
+*/
+int kheap_size(KHeap);
+
+
+/**
+ * Insert the payload with the given integer key in the heap of keys
+ * (the array grows by doubling when the heap is full)
+*/
+void kheap_add(KHeap, uint64_t, void*);
+
+
+/**
+ * Insert the payload with the given double key in the heap of keys
+*/
+void kheap_add_double(KHeap, double, void*);
+
+
+/**
+ * Return the payload of the top of the heap of keys, or NULL if its empty
+*/
+void* kheap_top(KHeap);
+
+
+/**
+ * Return the integer key of the top of the heap of keys (0 if its empty)
+*/
+uint64_t kheap_top_key(KHeap);
+
+
+/**
+ * Return the double key of the top of the heap of keys (0 if its empty)
+*/
+double kheap_top_key_double(KHeap);
+
+
+/**
+ * Delete the top of the heap of keys
+*/
+void kheap_pop(KHeap);
+
+
+/**
+ * Print the integer keys of the heap of keys
+*/
+void kheap_print(KHeap);
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef __MIX_H__
+#define __MIX_H__
+
+
+/**
+ * Mix the bits of the hash (murmur3 finalizer), so the low bits depend on all of them
+*/
+static inline unsigned hash_mix(unsigned hash) {
+
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+
+#endif
\ No newline at end of file
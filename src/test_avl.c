@@ -1,5 +1,6 @@
 #include "tree.h"
 #include "int.h"
+#include <assert.h>
 
 /**
  * I just found this code to print the tree (only for ints)
@@ -290,8 +291,141 @@ void print_ascii_tree(ATree  t)
 
 
 
+/**
+ * Keys of the random adds and deletes, and amount of them
+*/
+#define KEYS 2000
+#define STEPS 20000
+
+
+/**
+ * Check the AVL tree: each key between low and high (if they exist), each height
+ * is the one kept in the node, and the heights of the subtrees differ at most in one
+ * Return the height of the tree and count its nodes
+*/
+int check_tree(ATree tree, int* low, int* high, int* nodes) {
+
+  if (not tree) return 0;
+
+  int key = *(int*) tree->data;
+  assert(not low or *low < key);
+  assert(not high or key < *high);
+
+  int left = check_tree(tree->left, low, &key, nodes);
+  int right = check_tree(tree->right, &key, high, nodes);
+
+  assert(left - right <= 1 and right - left <= 1);
+  assert(tree->height == 1 + (left > right ? left : right));
+
+  (*nodes)++;
+  return tree->height;
+}
+
+
+/**
+ * Amount of nodes from the root to the key, or to the end of its path if it isnt in the tree
+ * (one compare each one)
+*/
+int path_length(ATree tree, int key) {
+
+  int length = 0;
+  while (tree) {
+    length++;
+    int other = *(int*) tree->data;
+    if (key == other) break;
+    tree = key > other ? tree->right : tree->left;
+  }
+
+  return length;
+}
+
+
+/**
+ * Random adds and deletes, checking the tree, its keys and the compares (one per node
+ * of the path) after each one,
+ * then delete all the keys left
+*/
+void check_random() {
+
+  AVL tree = avl_create(copy_int, destroy_int, compare_int, visit_int);
+  char present[KEYS] = {0};
+  int stuffed = 0, nodes;
+
+  srand(1);
+  for (int i = 0; i < STEPS; i++) {
+
+    int key = rand() % KEYS;
+    int add = rand() % 3 != 0;
+
+    int compares = path_length(tree->root, key);
+    if (add) avl_add(tree, &key);
+    else avl_delete(tree, &key);
+    assert(avl_compares(tree) == compares);
+
+    stuffed += add ? not present[key] : -present[key];
+    present[key] = add;
+
+    nodes = 0;
+    check_tree(tree->root, NULL, NULL, &nodes);
+    assert(nodes == stuffed);
+
+    int other = rand() % KEYS;
+    assert(avl_search_bool(tree, &other) == present[other]);
+    assert(avl_compares(tree) == path_length(tree->root, other));
+  }
+
+  // The height of an AVL tree of n nodes is less than 1.45 * log2(n + 2)
+  int height = check_tree(tree->root, NULL, NULL, &nodes);
+  printf("Random adds and deletes: %i keys, height %i\n", stuffed, height);
+  assert(height <= 15);
+
+  for (int key = 0; key < KEYS; key++) {
+    avl_delete(tree, &key);
+    nodes = 0;
+    check_tree(tree->root, NULL, NULL, &nodes);
+    assert(nodes == stuffed - present[key]);
+    stuffed -= present[key];
+  }
+  assert(not tree->root);
+
+  avl_destroy(tree);
+}
+
+
+/**
+ * Adds in order, and deletes from both ends, that need rotations at every level
+*/
+void check_sorted() {
+
+  AVL tree = avl_create(copy_int, destroy_int, compare_int, visit_int);
+  int nodes;
+
+  for (int key = 0; key < KEYS; key++) {
+    avl_add(tree, &key);
+    nodes = 0;
+    check_tree(tree->root, NULL, NULL, &nodes);
+    assert(nodes == key + 1);
+  }
+
+  for (int i = 0; i < KEYS / 2; i++) {
+    int key = i % 2 ? i / 2 : KEYS - 1 - i / 2;
+    avl_delete(tree, &key);
+    nodes = 0;
+    check_tree(tree->root, NULL, NULL, &nodes);
+    assert(nodes == KEYS - 1 - i);
+    assert(not avl_search_bool(tree, &key));
+  }
+
+  avl_destroy(tree);
+}
+
+
 int main() {
 
+  check_random();
+  check_sorted();
+  puts("Checks passed\n");
+
   AVL tree = avl_create(copy_int, destroy_int, compare_int, visit_int);
 
   int n;
@@ -1,5 +1,6 @@
 #include "tree.h"
 #include "int.h"
+#include <assert.h>
 
 /**
  * I just found this code to print the tree (only for ints)
@@ -290,8 +291,108 @@ void print_ascii_tree(BTree  t)
 
 
 
+/**
+ * Nodes of the degenerate trees, deeper than the native stack can recurse
+*/
+#define DEGENERATE 1000000
+
+
+/**
+ * Each visit checks that the data comes in the expected order
+*/
+int expected, step;
+
+void visit_check(void* data) {
+  assert(*(int*) data == expected);
+  expected += step;
+}
+
+
+/**
+ * Build a tree of only left (or only right) subtrees, so each node is deeper than
+ * the one before, and travel it in every order, get its height and destroy it
+*/
+void check_degenerate(int toLeft) {
+
+  // The root is the last node made, inorder goes from 0 up in both shapes
+  BTree tree = btree_create();
+  for (int i = 0; i < DEGENERATE; i++) {
+    int n = toLeft ? i : DEGENERATE - 1 - i;
+    tree = toLeft ? btree_union(&n, tree, NULL, copy_int) : btree_union(&n, NULL, tree, copy_int);
+  }
+
+  expected = 0, step = 1;
+  btree_travel(tree, IN, visit_check);
+  assert(expected == DEGENERATE);
+
+  expected = toLeft ? DEGENERATE - 1 : 0, step = toLeft ? -1 : 1;
+  btree_travel(tree, PRE, visit_check);
+
+  expected = toLeft ? 0 : DEGENERATE - 1, step = toLeft ? 1 : -1;
+  btree_travel(tree, POST, visit_check);
+
+  assert(btree_height(tree) == DEGENERATE - 1);
+
+  btree_destroy(tree, destroy_int);
+}
+
+
+/**
+ * Amount of nodes from the root to the key, or to the end of its path if it isnt in the tree
+ * (one compare each one)
+*/
+int path_length(BTree tree, int key) {
+
+  int length = 0;
+  while (tree) {
+    length++;
+    int other = *(int*) tree->data;
+    if (key == other) break;
+    tree = key > other ? tree->right : tree->left;
+  }
+
+  return length;
+}
+
+
+/**
+ * Random adds, searches and deletes, checking the keys and that each one compares
+ * once per node of its path
+*/
+void check_compares() {
+
+  BST tree = bst_create(copy_int, destroy_int, compare_int, visit_int);
+  char present[1000] = {0};
+
+  srand(1);
+  for (int i = 0; i < 20000; i++) {
+
+    int key = rand() % 1000;
+    int add = rand() % 3 != 0;
+
+    int compares = path_length(tree->root, key);
+    if (add) bst_add(tree, &key);
+    else bst_delete(tree, &key);
+    assert(bst_compares(tree) == compares);
+    present[key] = add;
+
+    int other = rand() % 1000;
+    assert(bst_search_bool(tree, &other) == present[other]);
+    assert(bst_compares(tree) == path_length(tree->root, other));
+  }
+
+  bst_destroy(tree);
+}
+
+
 int main() {
 
+  check_compares();
+
+  check_degenerate(true);
+  check_degenerate(false);
+  printf("Degenerate trees of %i nodes: travelled, measured and destroyed\n\n", DEGENERATE);
+
   BST tree = bst_create(copy_int, destroy_int, compare_int, visit_int);
 
   int n;
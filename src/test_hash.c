@@ -1,4 +1,5 @@
 #include "hash_probing.h"
+#include "int.h"
 #include <assert.h>
 #include <string.h>
 
@@ -97,11 +98,493 @@ void contacto_imprimir(Contacto *contacto) {
 }
 
 
+/**
+ * Hash an int to the same home cell always (every element collides)
+ */
+unsigned hash_constant(void* data) {
+  (void) data;
+  return 42;
+}
+
+
+/**
+ * Check that the table has the keys marked as present, and only them
+ */
+void check_keys(Hash table, char* present, int keys) {
+  int stuffed = 0;
+  for (int key = 0; key < keys; key++) {
+    assert((hash_search(table, &key) != NULL) == present[key]);
+    stuffed += present[key];
+  }
+  assert(hash_stuffed(table) == stuffed);
+}
+
+
+/**
+ * Random adds and deletes of the given amount of keys, checking the table against them at the end
+ */
+void check_random(Hash table, int keys, int steps) {
+  char* present = calloc(keys, 1);
+  for (int i = 0; i < steps; i++) {
+    int key = rand() % keys;
+    if (rand() % 2) {
+      hash_add(table, &key);
+      present[key] = 1;
+    } else {
+      hash_delete(table, &key);
+      present[key] = 0;
+    }
+  }
+  check_keys(table, present, keys);
+  free(present);
+}
+
+
+/**
+ * Cuadratic probing with a capacity that isnt a power of two doesnt go through all
+ * the cells, so with many collisions one rehash may not make room
+ */
+void test_cuadratic_collisions() {
+  Hash table = hash_create(7, CUADRATIC, copy_int, destroy_int, compare_int, visit_int, hash_constant);
+  check_random(table, 4096, 20000);
+  hash_destroy(table);
+}
+
+
+/**
+ * Hash an int by its value
+ */
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Linear probing deletes shift back the rest of the cluster, even when it wraps
+ * past the end of the array, and dont leave deleted cells
+ */
+void test_linear_shift_back() {
+  Hash table = hash_create(8, LINEAR, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  // Cluster from 6 that wraps: 6 14 22 7 (7 is at 1, its home is 7)
+  int keys[] = {6, 14, 22, 7};
+  for (int i = 0; i < 4; i++) hash_add(table, &keys[i]);
+  assert(*(int*) table->array[1].data == 7);
+
+  // Delete in the middle of the cluster
+  hash_delete(table, &keys[1]);
+  assert(*(int*) table->array[6].data == 6);
+  assert(*(int*) table->array[7].data == 22);
+  assert(*(int*) table->array[0].data == 7);
+  assert(table->array[1].data == NULL);
+  assert(hash_deleted(table) == 0 and hash_stuffed(table) == 3);
+
+  hash_search(table, &keys[3]);
+  assert(hash_probes(table) == 2);
+
+  hash_destroy(table);
+
+  // A max load of 1 is ignored, the table keeps an empty cell to stop the probing
+  table = hash_create(8, LINEAR, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  hash_set_max_load(table, 1);
+  assert(table->maxLoad < 1);
+  hash_set_max_load(table, 0.99);
+  for (int key = 0; key < 8; key++) hash_add(table, &key);
+  assert(hash_stuffed(table) < hash_capacity(table));
+
+  int key = 3;
+  hash_delete(table, &key);
+  char present[8] = {1, 1, 1, 0, 1, 1, 1, 1};
+  check_keys(table, present, 8);
+
+  hash_destroy(table);
+
+  // Random adds and deletes
+  table = hash_create(8, LINEAR, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  check_random(table, 1024, 20000);
+  assert(hash_deleted(table) == 0);
+  hash_destroy(table);
+}
+
+
+/**
+ * Return the int at the cell of the table (-1 if its empty)
+ */
+int cell_int(Hash table, int idx) {
+  return table->array[idx].data ? *(int*) table->array[idx].data : -1;
+}
+
+
+/**
+ * Hopscotch moves back the first empty cell into the neighbourhood, and on delete
+ * moves back the elements to the free cell
+ */
+void test_hopscotch_displacement() {
+  Hash table = hash_create(64, HOPSCOTCH, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  // Each of 0 ... 39 at its home cell
+  for (int key = 0; key < 40; key++) hash_add(table, &key);
+
+  // The first empty cell from 0 is 40, out of its neighbourhood, so 9 moves there and 64 takes its cell
+  int key = 64;
+  hash_add(table, &key);
+  assert(cell_int(table, 9) == 64 and cell_int(table, 40) == 9);
+  assert(table->array[0].hop == (1u | 1u << 9) and table->array[9].hop == 1u << 31);
+  assert(table->overflowed == 0 and hash_capacity(table) == 64);
+
+  // Deleting 64 moves back 9 to its home cell
+  hash_delete(table, &key);
+  assert(cell_int(table, 9) == 9 and cell_int(table, 40) == -1);
+  assert(table->array[0].hop == 1u and table->array[9].hop == 1u);
+
+  hash_destroy(table);
+}
+
+
+/**
+ * Hopscotch puts in the overflow the elements that dont fit in their neighbourhood,
+ * and places them again when the overflow is full
+ */
+void test_hopscotch_overflow() {
+  Hash table = hash_create(256, HOPSCOTCH, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  hash_set_max_load(table, 1);
+
+  // 96 keys of the home cell 0: 32 in its neighbourhood, 64 (the limit) in the overflow
+  for (int i = 0; i < 96; i++) {
+    int key = 256 * i;
+    hash_add(table, &key);
+  }
+  assert(table->overflowed == HOP_OVERFLOW and table->array[0].distance == HOP_OVERFLOW);
+
+  // Found in the overflow
+  int key = 256 * 95;
+  assert(hash_search(table, &key) != NULL);
+
+  // 60 keys at their home cells and a full neighbourhood at 200
+  for (key = 40; key < 100; key++) hash_add(table, &key);
+  for (int i = 0; i < 32; i++) {
+    key = 200 + 256 * i;
+    hash_add(table, &key);
+  }
+
+  // Free the neighbourhood of 0
+  for (int i = 0; i < 32; i++) {
+    key = 256 * i;
+    hash_delete(table, &key);
+  }
+  assert(table->overflowed == HOP_OVERFLOW);
+
+  // The next key of 200 doesnt fit, so the overflow is drained to the neighbourhood of 0 first
+  key = 200 + 256 * 32;
+  hash_add(table, &key);
+  assert(hash_capacity(table) == 256);
+  assert(table->overflowed == 33 and table->array[0].distance == 32 and table->array[200].distance == 1);
+
+  for (int i = 32; i < 96; i++) {
+    key = 256 * i;
+    assert(hash_search(table, &key) != NULL);
+  }
+  for (int i = 0; i < 33; i++) {
+    key = 200 + 256 * i;
+    assert(hash_search(table, &key) != NULL);
+  }
+  assert(hash_stuffed(table) == 64 + 60 + 33);
+
+  hash_destroy(table);
+
+  // Random adds and deletes with every key at the same home cell
+  table = hash_create(64, HOPSCOTCH, copy_int, destroy_int, compare_int, visit_int, hash_constant);
+  check_random(table, 512, 20000);
+  hash_destroy(table);
+}
+
+
+/**
+ * Check that each element of the Robin Hood table keeps its distance to its home cell
+ * (indexed by the modulo of the hash)
+ */
+void check_distances(Hash table) {
+  for (int idx = 0; idx < hash_capacity(table); idx++) {
+    if (not table->array[idx].data) continue;
+    int home = table->array[idx].hash % hash_capacity(table);
+    assert(table->array[idx].distance == (idx - home + hash_capacity(table)) % hash_capacity(table));
+  }
+}
+
+
+/**
+ * Robin Hood moves forward the richer elements when adding, stops the search at
+ * the first element richer than the key, and shifts back the cluster when deleting
+ */
+void test_robin_hood() {
+  Hash table = hash_create(16, ROBIN_HOOD, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  // 4 is at home, but 19 and 35 (home 3) are poorer, so they take its cell and push it forward
+  int keys[] = {4, 3, 19, 35};
+  for (int i = 0; i < 4; i++) hash_add(table, &keys[i]);
+  assert(cell_int(table, 3) == 3 and cell_int(table, 4) == 19 and cell_int(table, 5) == 35 and cell_int(table, 6) == 4);
+  assert(table->array[5].distance == 2 and table->array[6].distance == 2);
+  check_distances(table);
+
+  // 51 would be at distance 3 at the cell of 4, that is richer, so it isnt further on
+  int key = 51;
+  assert(hash_search(table, &key) == NULL and hash_probes(table) == 4);
+
+  // Deleting 19 shifts back 35 and 4, without deleted cells
+  hash_delete(table, &keys[2]);
+  assert(cell_int(table, 4) == 35 and cell_int(table, 5) == 4 and cell_int(table, 6) == -1);
+  assert(table->array[4].distance == 1 and table->array[5].distance == 1);
+  assert(hash_deleted(table) == 0 and hash_stuffed(table) == 3);
+  check_distances(table);
+
+  hash_destroy(table);
+
+  // Random adds and deletes, with spread and with colliding hashes
+  table = hash_create(16, ROBIN_HOOD, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  check_random(table, 2048, 20000);
+  check_distances(table);
+  assert(hash_deleted(table) == 0);
+  hash_destroy(table);
+
+  table = hash_create(16, ROBIN_HOOD, copy_int, destroy_int, compare_int, visit_int, hash_constant);
+  check_random(table, 256, 5000);
+  check_distances(table);
+  hash_destroy(table);
+}
+
+
+/**
+ * Calls to the hash and compare functions
+ */
+int hashes, compares;
+
+unsigned hash_counted(void* data) {
+  hashes++;
+  return hash_int(data);
+}
+
+int compare_counted(void* a, void* b) {
+  compares++;
+  return compare_int(a, b);
+}
+
+
+/**
+ * Each cell keeps the hash of its element: searches only compare the elements
+ * with the same hash, and resizes dont hash again
+ */
+void test_cached_hashes() {
+  for (ProbingType type = LINEAR; type <= HOPSCOTCH; type++) {
+    Hash table = hash_create(64, type, copy_int, destroy_int, compare_counted, visit_int, hash_counted);
+
+    // Every key has the home cell 0
+    for (int i = 0; i < 8; i++) {
+      int key = 64 * i;
+      hash_add(table, &key);
+    }
+
+    for (int i = 0; i < 8; i++) {
+      int key = 64 * i;
+      compares = 0;
+      assert(hash_search(table, &key) != NULL and compares == 1);
+    }
+    int key = 64 * 8;
+    compares = 0;
+    assert(hash_search(table, &key) == NULL and compares == 0);
+
+    hashes = 0;
+    hash_rehash(table);
+    assert(hashes == 0 and hash_capacity(table) == 128 and hash_stuffed(table) == 8);
+
+    hash_destroy(table);
+  }
+}
+
+
+/**
+ * Cuadratic and double hashing count their deleted cells, reuse them, and clean them
+ * (rebuilding at the same capacity) when they are most of the load
+ */
+void test_deleted_cells() {
+  for (ProbingType type = CUADRATIC; type <= DOUBLE_HASHING; type++) {
+    Hash table = hash_create(64, type, copy_int, destroy_int, compare_int, visit_int, hash_int);
+    char present[128] = {0};
+
+    // Each key at its home cell
+    for (int key = 0; key < 40; key++) {
+      hash_add(table, &key);
+      present[key] = 1;
+    }
+    for (int key = 0; key < 10; key++) {
+      hash_delete(table, &key);
+      present[key] = 0;
+    }
+    assert(hash_deleted(table) == 10 and hash_stuffed(table) == 30);
+
+    // Adding again takes the deleted cells
+    for (int key = 0; key < 5; key++) {
+      hash_add(table, &key);
+      present[key] = 1;
+    }
+    assert(hash_deleted(table) == 5 and hash_stuffed(table) == 35);
+
+    // With more deleted cells than half of the elements, the load cleans them
+    for (int key = 10; key < 30; key++) {
+      hash_delete(table, &key);
+      present[key] = 0;
+    }
+    assert(hash_deleted(table) == 25 and hash_stuffed(table) == 15);
+    int key;
+    for (key = 40; hash_deleted(table) > 0; key++) {
+      hash_add(table, &key);
+      present[key] = 1;
+    }
+    assert(hash_capacity(table) == 64 and hash_stuffed(table) == 15 + key - 40);
+    check_keys(table, present, 128);
+
+    // Without deleted cells, the load doubles the capacity
+    for (; hash_capacity(table) == 64; key++) {
+      hash_add(table, &key);
+      present[key] = 1;
+    }
+    assert(hash_capacity(table) == 128 and hash_deleted(table) == 0);
+    check_keys(table, present, 128);
+
+    hash_destroy(table);
+  }
+}
+
+
+/**
+ * Every type halves its capacity when the load drops below UNDERLOAD_CHARGE_FACTOR,
+ * but not below the capacity given at creation
+ */
+void test_shrink() {
+  for (ProbingType type = LINEAR; type <= HOPSCOTCH; type++) {
+    Hash table = hash_create(16, type, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+    for (int key = 0; key < 1000; key++) hash_add(table, &key);
+    int capacity = hash_capacity(table);
+
+    char present[1000];
+    memset(present, 1, 1000);
+    for (int key = 0; key < 1000; key++) {
+      hash_delete(table, &key);
+      present[key] = 0;
+      assert(hash_capacity(table) == 16 or hash_stuffed(table) >= UNDERLOAD_CHARGE_FACTOR * hash_capacity(table));
+      if (key % 100 == 0) check_keys(table, present, 1000);
+    }
+    assert(capacity >= 1024 and hash_capacity(table) == 16 and hash_stuffed(table) == 0);
+
+    hash_destroy(table);
+  }
+}
+
+
+/**
+ * Search in batches of many sizes the keys from 0 to 2 * amount (the odd ones
+ * arent in the table), and check each result against hash_search
+ */
+void check_batch(Hash table, int amount) {
+  int sizes[] = {0, 1, SEARCH_BATCH - 1, SEARCH_BATCH, SEARCH_BATCH + 1, 2 * amount};
+  int* keys = malloc(sizeof(int) * 2 * amount);
+  void* *pointers = malloc(sizeof(void*) * 2 * amount);
+  void* *out = malloc(sizeof(void*) * 2 * amount);
+
+  for (int i = 0; i < 2 * amount; i++) {
+    keys[i] = rand() % (2 * amount);
+    pointers[i] = &keys[i];
+  }
+
+  for (int s = 0; s < 6; s++) {
+    hash_search_batch(table, pointers, sizes[s], out);
+    for (int i = 0; i < sizes[s]; i++) {
+      assert(out[i] == hash_search(table, pointers[i]));
+      assert(keys[i] % 2 ? out[i] == NULL : out[i] and *(int*) out[i] == keys[i]);
+    }
+  }
+
+  free(keys);
+  free(pointers);
+  free(out);
+}
+
+
+/**
+ * Batches give the same as single searches, in every type, with spread hashes and
+ * with colliding ones (far from home for Robin Hood, in the overflow for hopscotch)
+ */
+void test_search_batch() {
+  for (ProbingType type = LINEAR; type <= HOPSCOTCH; type++) {
+    Hash table = hash_create(16, type, copy_int, destroy_int, compare_int, visit_int, hash_int);
+    for (int key = 0; key < 2000; key += 2) hash_add(table, &key);
+    check_batch(table, 1000);
+    hash_destroy(table);
+
+    table = hash_create(256, type, copy_int, destroy_int, compare_int, visit_int, hash_constant);
+    for (int key = 0; key < 160; key += 2) hash_add(table, &key);
+    if (type == HOPSCOTCH) assert(table->overflowed > 0);
+    check_batch(table, 80);
+    hash_destroy(table);
+  }
+}
+
+
+/**
+ * Switching the power of two mode on and off with elements in the table keeps them,
+ * and random adds and deletes work in both modes
+ */
+void test_power_of_two() {
+  for (ProbingType type = LINEAR; type <= HOPSCOTCH; type++) {
+    Hash table = hash_create(100, type, copy_int, destroy_int, compare_int, visit_int, hash_int);
+    char present[1024] = {0};
+    for (int key = 0; key < 60; key++) {
+      hash_add(table, &key);
+      present[key] = 1;
+    }
+
+    hash_set_power_of_two(table, true);
+    assert(hash_capacity(table) == 128 and table->minCapacity == 128);
+    check_keys(table, present, 1024);
+
+    // Random adds and deletes, switching the mode from time to time
+    for (int i = 0; i < 20000; i++) {
+      int key = rand() % 1024;
+      int add = rand() % 2;
+      if (add) hash_add(table, &key);
+      else hash_delete(table, &key);
+      present[key] = add;
+      if (i % 5000 == 0) {
+        hash_set_power_of_two(table, not table->powerOfTwo);
+        check_keys(table, present, 1024);
+      }
+      if (table->powerOfTwo) assert((hash_capacity(table) & (hash_capacity(table) - 1)) == 0);
+    }
+    check_keys(table, present, 1024);
+
+    hash_destroy(table);
+  }
+}
+
+
 /**
  * Caso de prueba: table hash para contactos
  */
 int main() {
 
+  srand(1);
+  test_cuadratic_collisions();
+  test_linear_shift_back();
+  test_hopscotch_displacement();
+  test_hopscotch_overflow();
+  test_robin_hood();
+  test_cached_hashes();
+  test_deleted_cells();
+  test_shrink();
+  test_search_batch();
+  test_power_of_two();
+  puts("Checks passed");
+
 
   // Iniciar table hash
   Hash table = hash_create(CAPACIDAD_INICIAL, LINEAR,
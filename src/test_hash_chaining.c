@@ -0,0 +1,175 @@
+#include "hash_chaining.h"
+#include "int.h"
+#include <assert.h>
+
+#define KEYS 4096
+#define STEPS 100000
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Check that the table has the keys marked as present, and only them
+*/
+void check_keys(ChainingHash table, char* present, int keys) {
+  int stuffed = 0;
+  for (int key = 0; key < keys; key++) {
+    int* found = chaining_search(table, &key);
+    assert(present[key] ? found and *found == key : not found);
+    stuffed += present[key];
+  }
+  assert(chaining_stuffed(table) == stuffed);
+}
+
+
+/**
+ * Random adds, deletes and searches, moving the given amount of cells per operation
+ * while rehashing, checking each one against a plain array
+*/
+void check_incremental(int step) {
+  ChainingHash table = chaining_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  chaining_set_incremental(table, step);
+  char present[KEYS] = {0};
+  int stuffed = 0, rehashing = 0;
+
+  for (int i = 0; i < STEPS; i++) {
+    int key = rand() % KEYS;
+    int add = rand() % 4 != 0;
+    if (add) chaining_add(table, &key);
+    else chaining_delete(table, &key);
+    stuffed += add ? not present[key] : -present[key];
+    present[key] = add;
+    assert(chaining_stuffed(table) == stuffed);
+
+    int other = rand() % KEYS;
+    int* found = chaining_search(table, &other);
+    assert(present[other] ? found and *found == other : not found);
+
+    rehashing += table->oldArray exist;
+  }
+
+  check_keys(table, present, KEYS);
+  printf("Step %i: %i keys, capacity %i, %i operations while rehashing\n", step, stuffed, chaining_capacity(table), rehashing);
+  assert(step == 0 ? rehashing == 0 : rehashing > 0);
+
+  chaining_destroy(table);
+}
+
+
+/**
+ * Turning off the incremental rehash in the middle of one finishes it,
+ * so the table keeps growing at once
+*/
+void check_incremental_off() {
+  ChainingHash table = chaining_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  chaining_set_incremental(table, 1);
+
+  int n;
+  for (n = 0; not table->oldArray; n++) chaining_add(table, &n);
+  assert(chaining_capacity(table) == 32);
+
+  chaining_set_incremental(table, 0);
+  assert(not table->oldArray);
+
+  for (; n < 100000; n++) chaining_add(table, &n);
+  assert(not table->oldArray and chaining_capacity(table) >= 100000 / CHAINING_OVERLOAD_CHARGE_FACTOR / 2);
+
+  char* present = malloc(n);
+  for (int i = 0; i < n; i++) present[i] = 1;
+  check_keys(table, present, n);
+  free(present);
+
+  chaining_destroy(table);
+}
+
+
+/**
+ * Batches of many sizes give the same as single searches, with misses among the keys,
+ * also while rehashing incrementally
+*/
+void check_batch(int step) {
+  ChainingHash table = chaining_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  chaining_set_incremental(table, step);
+
+  // The odd keys arent in the table, and the last adds start a rehash
+  int n;
+  for (n = 0; n < 1000 or (step and not table->oldArray); n += 2) chaining_add(table, &n);
+
+  int keys[2 * KEYS];
+  void* pointers[2 * KEYS], *out[2 * KEYS];
+  for (int i = 0; i < 2 * KEYS; i++) {
+    keys[i] = rand() % (n + 100);
+    pointers[i] = &keys[i];
+  }
+
+  int sizes[] = {0, 1, CHAINING_SEARCH_BATCH - 1, CHAINING_SEARCH_BATCH, CHAINING_SEARCH_BATCH + 1, 2 * KEYS};
+  for (int s = 0; s < 6; s++) {
+    chaining_search_batch(table, pointers, sizes[s], out);
+    for (int i = 0; i < sizes[s]; i++) {
+      assert(out[i] == chaining_search(table, pointers[i]));
+      assert(keys[i] % 2 or keys[i] >= n ? out[i] == NULL : out[i] and *(int*) out[i] == keys[i]);
+    }
+  }
+
+  chaining_destroy(table);
+}
+
+
+/**
+ * Switching the power of two mode on and off with elements in the table keeps them,
+ * also in the middle of an incremental rehash
+*/
+void check_power_of_two() {
+  ChainingHash table = chaining_create(100, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  chaining_set_incremental(table, 1);
+  char present[KEYS] = {0};
+
+  int n;
+  for (n = 0; not table->oldArray; n++) {
+    chaining_add(table, &n);
+    present[n] = 1;
+  }
+
+  chaining_set_power_of_two(table, true);
+  assert(not table->oldArray and chaining_capacity(table) == 256);
+  check_keys(table, present, KEYS);
+
+  for (int i = 0; i < 3 * KEYS; i++) {
+    int key = rand() % KEYS;
+    int add = rand() % 2;
+    if (add) chaining_add(table, &key);
+    else chaining_delete(table, &key);
+    present[key] = add;
+
+    // Switch the mode from time to time
+    if (i % KEYS == 0) chaining_set_power_of_two(table, not table->powerOfTwo);
+  }
+  check_keys(table, present, KEYS);
+
+  chaining_set_power_of_two(table, false);
+  check_keys(table, present, KEYS);
+
+  chaining_destroy(table);
+}
+
+
+int main() {
+
+  srand(1);
+  check_incremental(0);
+  check_incremental(1);
+  check_incremental(4);
+  check_incremental_off();
+  check_batch(0);
+  check_batch(1);
+  check_power_of_two();
+
+  puts("Checks passed");
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "hash_concurrent.h"
+#include "int.h"
+
+#define THREADS 4
+#define PER_THREAD 1000
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+CHash table;
+
+
+/**
+ * Add the keys of the thread, then delete the odd ones
+*/
+void* work(void* argument) {
+  int first = *(int*) argument * PER_THREAD;
+  for (int n = first; n < first + PER_THREAD; n++) chash_add(table, &n);
+  for (int n = first + 1; n < first + PER_THREAD; n += 2) chash_delete(table, &n);
+  return NULL;
+}
+
+
+int main() {
+
+  table = chash_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  pthread_t ids[THREADS];
+  int firsts[THREADS];
+
+  printf("%i threads add %i keys each, then delete the odd ones\n", THREADS, PER_THREAD);
+  for (int i = 0; i < THREADS; i++) {
+    firsts[i] = i;
+    pthread_create(&ids[i], NULL, work, &firsts[i]);
+  }
+  for (int i = 0; i < THREADS; i++) pthread_join(ids[i], NULL);
+  printf("Capacity: %i Stuffed: %i\n", chash_capacity(table), chash_stuffed(table));
+  puts("");
+
+  puts("Search 1000 and 1001");
+  int n = 1000;
+  int* copy = chash_search(table, &n);
+  visit_int(copy);
+  destroy_int(copy);
+  n = 1001;
+  visit_int(chash_search(table, &n));
+  puts("\n");
+
+  puts("Contains 3998 and 3999");
+  n = 3998;
+  printf("%i ", chash_contains(table, &n));
+  n = 3999;
+  printf("%i\n", chash_contains(table, &n));
+
+  chash_destroy(table);
+
+  puts("");
+  return 0;
+}
\ No newline at end of file
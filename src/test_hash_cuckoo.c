@@ -0,0 +1,180 @@
+#include "hash_cuckoo.h"
+#include "int.h"
+#include <assert.h>
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Hash an int to the same value always (every element has the same two buckets)
+*/
+unsigned hash_constant(void* data) {
+  (void) data;
+  return 42;
+}
+
+
+/**
+ * Check that the keys from 0 to the given amount are in the table
+*/
+void check_keys(CuckooHash table, int amount) {
+  for (int n = 0; n < amount; n++) {
+    int* found = cuckoo_search(table, &n);
+    assert(found and *found == n);
+  }
+  int n = amount;
+  assert(not cuckoo_search(table, &n));
+  assert(cuckoo_stuffed(table) == amount);
+}
+
+
+/**
+ * Near the max load, some adds have to kick out elements to their other bucket
+*/
+void test_kicks() {
+  CuckooHash table = cuckoo_create(1024, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  int amount = cuckoo_capacity(table) * 0.85, kicked = 0, maxKicks = 0;
+  for (int n = 0; n < amount; n++) {
+    cuckoo_add(table, &n);
+    kicked += cuckoo_kicks(table) > 0;
+    if (cuckoo_kicks(table) > maxKicks) maxKicks = cuckoo_kicks(table);
+  }
+  printf("Adds with kicks: %i (max %i), stashed: %i\n", kicked, maxKicks, table->stashed);
+  assert(kicked > 0 and cuckoo_capacity(table) == 1024);
+  check_keys(table, amount);
+
+  cuckoo_destroy(table);
+}
+
+
+/**
+ * The elements with the same hash fill their two buckets, then the stash, and then
+ * the rebuilds cant place them, so the stash grows
+*/
+void test_stash() {
+  CuckooHash table = cuckoo_create(1024, copy_int, destroy_int, compare_int, visit_int, hash_constant);
+
+  // Two buckets and the stash
+  int n;
+  for (n = 0; n < 2 * CUCKOO_WAYS + CUCKOO_STASH; n++) cuckoo_add(table, &n);
+  printf("Same hash: %i elements, stashed: %i\n", n, table->stashed);
+  assert(table->stashed == CUCKOO_STASH and not table->spilled);
+  assert(cuckoo_kicks(table) == CUCKOO_MAX_KICKS);
+  check_keys(table, n);
+
+  // One more makes the table rebuild, CUCKOO_MAX_REBUILDS times, and then it spills to the stash
+  cuckoo_add(table, &n);
+  n++;
+  printf("Same hash: %i elements, stashed: %i, capacity: %i\n", n, table->stashed, cuckoo_capacity(table));
+  assert(table->spilled and table->stashed == n - 2 * CUCKOO_WAYS);
+  assert(cuckoo_capacity(table) <= 4 * 1024);
+  check_keys(table, n);
+
+  // After spilled, the stash takes the next ones without rebuild
+  int capacity = cuckoo_capacity(table);
+  for (; n < 100; n++) cuckoo_add(table, &n);
+  assert(cuckoo_capacity(table) == capacity and table->stashed == n - 2 * CUCKOO_WAYS);
+  check_keys(table, n);
+
+  // Deleting from the buckets moves back an element of the stash
+  int inBucket = -1;
+  for (int i = 0; i < table->capacity and inBucket == -1; i++) {
+    if (table->buckets[i].data[0]) inBucket = *(int*) table->buckets[i].data[0];
+  }
+  cuckoo_delete(table, &inBucket);
+  assert(cuckoo_stuffed(table) == 99 and table->stashed == 99 - 2 * CUCKOO_WAYS);
+  assert(not cuckoo_search(table, &inBucket));
+
+  // Deleting from the stash
+  for (int i = 0; i < 100; i++) cuckoo_delete(table, &i);
+  assert(cuckoo_stuffed(table) == 0 and table->stashed == 0);
+
+  cuckoo_destroy(table);
+}
+
+
+/**
+ * A rebuild changes the seeds of the hashes and keeps all the elements
+*/
+void test_rebuild() {
+  CuckooHash table = cuckoo_create(64, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  int n;
+  for (n = 0; n < 57; n++) cuckoo_add(table, &n);
+  unsigned seeds[2] = {table->seeds[0], table->seeds[1]};
+  assert(cuckoo_capacity(table) == 64);
+
+  // Past the max load it rebuilds at double capacity
+  cuckoo_add(table, &n);
+  n++;
+  printf("Rebuilt: capacity %i, seeds %08x %08x -> %08x %08x\n", cuckoo_capacity(table), seeds[0], seeds[1],
+    table->seeds[0], table->seeds[1]);
+  assert(cuckoo_capacity(table) == 128);
+  assert(table->seeds[0] != seeds[0] and table->seeds[1] != seeds[1]);
+  check_keys(table, n);
+
+  // The table can also be rebuilt on demand
+  seeds[0] = table->seeds[0];
+  cuckoo_rehash(table);
+  assert(cuckoo_capacity(table) == 256 and table->seeds[0] != seeds[0] and not table->spilled);
+  check_keys(table, n);
+
+  cuckoo_destroy(table);
+}
+
+
+/**
+ * Hash an int to one of three values
+*/
+unsigned hash_three(void* data) {
+  return (unsigned) *(int*) data % 3;
+}
+
+
+/**
+ * Random adds and deletes of few hashes (so kicks, stash, spills and rebuilds mix),
+ * checking the keys against a plain array
+*/
+void test_churn() {
+  CuckooHash table = cuckoo_create(16, copy_int, destroy_int, compare_int, visit_int, hash_three);
+  char present[60] = {0};
+  int stuffed = 0;
+
+  for (int i = 0; i < 20000; i++) {
+    int key = rand() % 60;
+    int add = rand() % 3 != 0;
+    if (add) cuckoo_add(table, &key);
+    else cuckoo_delete(table, &key);
+    stuffed += add ? not present[key] : -present[key];
+    present[key] = add;
+    assert(cuckoo_stuffed(table) == stuffed);
+  }
+
+  for (int key = 0; key < 60; key++) {
+    int* found = cuckoo_search(table, &key);
+    assert(present[key] ? found and *found == key : not found);
+  }
+  printf("Three hashes: %i keys, capacity %i, stashed %i\n", stuffed, cuckoo_capacity(table), table->stashed);
+
+  cuckoo_destroy(table);
+}
+
+
+int main() {
+
+  srand(1);
+  test_kicks();
+  test_stash();
+  test_rebuild();
+  test_churn();
+
+  puts("Checks passed");
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "hash_lockfree.h"
+#include "int.h"
+#include <assert.h>
+
+#define READERS 4
+#define WRITERS 4
+#define STABLE 512
+#define PER_WRITER 20000
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+LHash table;
+_Atomic int writing;
+
+
+/**
+ * While the writers run, check that every stable key (0 ... STABLE - 1) is found
+ * and that the keys never added (negative) are not, return the amount of passes
+*/
+void* reader(void* argument) {
+  (void) argument;
+  long passes = 0;
+  do {
+    for (int n = 0; n < STABLE; n++) {
+      assert(lfhash_contains(table, &n));
+      int* copy = lfhash_search(table, &n);
+      assert(copy and *copy == n);
+      destroy_int(copy);
+      int missing = -1 - n;
+      assert(not lfhash_contains(table, &missing));
+    }
+    passes++;
+  } while (atomic_load(&writing));
+  return (void*) passes;
+}
+
+
+/**
+ * Add the keys of the writer (so the cells double many times), check that
+ * adding them again changes nothing, then delete them
+*/
+void* writer(void* argument) {
+  int first = STABLE + *(int*) argument * PER_WRITER;
+  for (int n = first; n < first + PER_WRITER; n++) assert(lfhash_add(table, &n));
+  for (int n = first; n < first + PER_WRITER; n++) assert(not lfhash_add(table, &n));
+  for (int n = first; n < first + PER_WRITER; n++) assert(lfhash_delete(table, &n));
+  for (int n = first; n < first + PER_WRITER; n++) assert(not lfhash_delete(table, &n));
+  return NULL;
+}
+
+
+/**
+ * Check that the list is sorted by key, and has as many data nodes as elements
+*/
+void check_list() {
+  LList node = atomic_load(&atomic_load(&table->segments[0])[0]);
+  int data = 0;
+  for (LList next; (next = (LList) (atomic_load(&node->next) & ~(uintptr_t) 1)); node = next) {
+    assert(next->key > node->key);
+    assert(not (atomic_load(&node->next) & 1));
+    data += next->data != NULL;
+  }
+  assert(data == lfhash_stuffed(table));
+}
+
+
+int main() {
+
+  table = lfhash_create(2, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  // Each thread has its own cache line
+  assert((uintptr_t) table % 64 == 0 and (uintptr_t) &table->threads[1] % 64 == 0);
+
+  for (int n = 0; n < STABLE; n++) lfhash_add(table, &n);
+  int cells = lfhash_capacity(table);
+
+  pthread_t readers[READERS], writers[WRITERS];
+  int firsts[WRITERS];
+
+  printf("%i readers search %i keys while %i writers add and delete %i keys each\n", READERS, STABLE, WRITERS, PER_WRITER);
+  atomic_store(&writing, true);
+  for (int i = 0; i < READERS; i++) pthread_create(&readers[i], NULL, reader, NULL);
+  for (int i = 0; i < WRITERS; i++) {
+    firsts[i] = i;
+    pthread_create(&writers[i], NULL, writer, &firsts[i]);
+  }
+  for (int i = 0; i < WRITERS; i++) pthread_join(writers[i], NULL);
+  atomic_store(&writing, false);
+
+  for (int i = 0; i < READERS; i++) {
+    void* passes;
+    pthread_join(readers[i], &passes);
+    printf("Reader %i: %li passes\n", i, (long) passes);
+  }
+
+  // The cells doubled while the readers searched
+  printf("Cells: %i -> %i Stuffed: %i\n", cells, lfhash_capacity(table), lfhash_stuffed(table));
+  assert(lfhash_capacity(table) >= 16 * cells);
+  assert(lfhash_stuffed(table) == STABLE);
+
+  check_list();
+
+  lfhash_destroy(table);
+
+  puts("");
+  return 0;
+}
\ No newline at end of file
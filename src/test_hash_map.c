@@ -0,0 +1,164 @@
+#include "hash_map.h"
+#include "string.h"
+#include "int.h"
+#include <assert.h>
+
+
+/**
+ * Hash a string (K&R)
+*/
+unsigned KRHash(void* data) {
+  unsigned hashval = 0;
+  for (char* s = data; *s != '\0'; ++s) {
+    hashval = *s + 31 * hashval;
+  }
+  return hashval;
+}
+
+
+/**
+ * Add the argument to the value (or start it at the argument)
+*/
+void* add_int(void* value, void* argument) {
+  if (not value) return copy_int(argument);
+  *(int*) value += *(int*) argument;
+  return value;
+}
+
+
+/**
+ * Hash an int to the same value always (every key collides)
+*/
+unsigned hash_constant(void* data) {
+  (void) data;
+  return 42;
+}
+
+
+/**
+ * Keys visited by map_print
+*/
+int visited;
+
+void visit_counted(void* data) {
+  visited++;
+  visit_int(data);
+}
+
+
+/**
+ * Each operation of the map, checking its values and size after each one
+*/
+void check_operations(ProbingType type) {
+  Map map = map_create(8, type, copy_string, destroy_string, copy_int, destroy_int, compare_string,
+    visit_string, visit_int, KRHash);
+  int n = 1;
+
+  // Put and get, and put again replaces the value
+  map_put(map, "uno", &n);
+  assert(map_size(map) == 1 and *(int*) map_get(map, "uno") == 1);
+  n = 10;
+  map_put(map, "uno", &n);
+  assert(map_size(map) == 1 and *(int*) map_get(map, "uno") == 10);
+
+  // A miss
+  assert(map_get(map, "dos") == NULL and map_size(map) == 1);
+
+  // Get or insert gives the slot of the value it had, or of a copy of the given one
+  n = 0;
+  int* *slot = (int**) map_get_or_insert(map, "uno", &n);
+  assert(**slot == 10 and map_size(map) == 1);
+  slot = (int**) map_get_or_insert(map, "dos", &n);
+  assert(**slot == 0 and map_size(map) == 2);
+  **slot = 2;
+  assert(*(int*) map_get(map, "dos") == 2);
+
+  // Upsert starts the value or adds to it
+  int one = 1;
+  map_upsert(map, "tres", add_int, &one);
+  assert(*(int*) map_get(map, "tres") == 1 and map_size(map) == 3);
+  map_upsert(map, "tres", add_int, &one);
+  map_upsert(map, "tres", add_int, &one);
+  assert(*(int*) map_get(map, "tres") == 3 and map_size(map) == 3);
+
+  // Remove and take gives the value, and then it is a miss
+  int* taken = map_remove_and_take(map, "uno");
+  assert(taken and *taken == 10 and map_size(map) == 2);
+  destroy_int(taken);
+  assert(map_get(map, "uno") == NULL and map_remove_and_take(map, "uno") == NULL and map_size(map) == 2);
+
+  // Many keys, so the table grows
+  char key[16];
+  for (int i = 0; i < 1000; i++) {
+    sprintf(key, "k%i", i);
+    map_put(map, key, &i);
+  }
+  assert(map_size(map) == 1002);
+  for (int i = 0; i < 1000; i++) {
+    sprintf(key, "k%i", i);
+    assert(*(int*) map_get(map, key) == i);
+  }
+
+  map_destroy(map);
+}
+
+
+int main() {
+
+  for (ProbingType type = LINEAR; type <= HOPSCOTCH; type++) check_operations(type);
+
+  // A hopscotch map prints the pairs in the overflow too
+  Map colliding = map_create(64, HOPSCOTCH, copy_int, destroy_int, copy_int, destroy_int, compare_int,
+    visit_counted, visit_int, hash_constant);
+  for (int i = 0; i < 40; i++) map_put(colliding, &i, &i);
+  assert(colliding->table->overflowed > 0);
+  visited = 0;
+  map_print(colliding);
+  assert(visited == 40);
+  map_destroy(colliding);
+  puts("Checks passed\n");
+
+
+  Map map = map_create(8, LINEAR, copy_string, destroy_string, copy_int, destroy_int, compare_string,
+    visit_string, visit_int, KRHash);
+
+  char* words[] = {"uno", "dos", "tres", "dos", "uno", "dos"};
+  int one = 1;
+
+  puts("Count the words: uno dos tres dos uno dos");
+  for (int i = 0; i < 6; i++) map_upsert(map, words[i], add_int, &one);
+  map_print(map);
+  puts("");
+
+  puts("Put cuatro: 4");
+  int n = 4;
+  map_put(map, "cuatro", &n);
+  printf("Size: %i\n", map_size(map));
+  puts("");
+
+  puts("Get dos and cinco");
+  visit_int(map_get(map, "dos"));
+  visit_int(map_get(map, "cinco"));
+  puts("\n");
+
+  puts("Get or insert cinco (0), then add 5 through its slot");
+  n = 0;
+  int* *slot = (int**) map_get_or_insert(map, "cinco", &n);
+  **slot += 5;
+  visit_int(map_get(map, "cinco"));
+  puts("\n");
+
+  puts("Remove and take uno");
+  int* taken = map_remove_and_take(map, "uno");
+  visit_int(taken);
+  destroy_int(taken);
+  printf("\nSize: %i\n", map_size(map));
+  puts("");
+
+  map_print(map);
+
+  map_destroy(map);
+
+  puts("");
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "hash_swiss.h"
+#include "int.h"
+#include "mix.h"
+#include <assert.h>
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Hash an int to the same value always (every element has the same first group)
+*/
+unsigned hash_constant(void* data) {
+  (void) data;
+  return 42;
+}
+
+
+/**
+ * Check that the keys from first to last are in the table, and the next one isnt
+*/
+void check_keys(SwissHash table, int first, int last) {
+  for (int n = first; n <= last; n++) {
+    int* found = swiss_search(table, &n);
+    assert(found and *found == n);
+  }
+  int n = last + 1;
+  assert(not swiss_search(table, &n));
+}
+
+
+/**
+ * Keys whose first group starts at the last cell take the first cells of the array,
+ * read through the copy of their control bytes at the end
+*/
+void test_wrap() {
+  SwissHash table = swiss_create(64, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  int mask = swiss_capacity(table) - 1, keys[8], found = 0;
+
+  // The first group of a key starts at the low bits of its mixed hash
+  for (int n = 0; found < 8; n++) {
+    if ((int) (hash_mix(n) & mask) == mask) keys[found++] = n;
+  }
+  for (int i = 0; i < 8; i++) swiss_add(table, &keys[i]);
+
+  assert(table->control[mask] >= 0 and *(int*) table->array[mask] == keys[0]);
+  for (int i = 0; i < 7; i++) {
+    assert(table->control[i] >= 0 and table->control[i] == table->control[swiss_capacity(table) + i]);
+    assert(*(int*) table->array[i] == keys[i + 1]);
+  }
+  for (int i = 0; i < 8; i++) assert(*(int*) swiss_search(table, &keys[i]) == keys[i]);
+
+  // Deleting updates the copy too
+  swiss_delete(table, &keys[3]);
+  assert(table->control[2] == SWISS_DELETED and table->control[swiss_capacity(table) + 2] == SWISS_DELETED);
+  assert(not swiss_search(table, &keys[3]) and *(int*) swiss_search(table, &keys[7]) == keys[7]);
+
+  swiss_destroy(table);
+}
+
+
+/**
+ * Deleted cells are counted, taken again by the adds, and cleaned at the same
+ * capacity when they are most of the load
+*/
+void test_deleted() {
+  SwissHash table = swiss_create(64, copy_int, destroy_int, compare_int, visit_int, hash_constant);
+
+  // All in a row from the same first group, adding again takes the deleted cell
+  for (int n = 0; n < 10; n++) swiss_add(table, &n);
+  int n = 3;
+  swiss_delete(table, &n);
+  assert(table->deleted == 1 and swiss_stuffed(table) == 9 and not swiss_search(table, &n));
+  n = 100;
+  swiss_add(table, &n);
+  assert(table->deleted == 0 and swiss_stuffed(table) == 10 and *(int*) table->array[(hash_mix(42) + 3) & 63] == 100);
+
+  swiss_destroy(table);
+
+  // Spread keys, most of them deleted
+  table = swiss_create(64, copy_int, destroy_int, compare_int, visit_int, hash_int);
+  for (n = 0; n < 50; n++) swiss_add(table, &n);
+  for (n = 0; n < 40; n++) swiss_delete(table, &n);
+  assert(table->deleted == 40 and swiss_stuffed(table) == 10);
+
+  // Adding new keys, the table is rebuilt at the same capacity without deleted cells
+  int cleaned = false;
+  for (n = 1000; not cleaned; n++) {
+    int deleted = table->deleted;
+    swiss_add(table, &n);
+    cleaned = deleted > 1 and table->deleted == 0;
+  }
+  assert(swiss_capacity(table) == 64);
+  check_keys(table, 40, 49);
+  check_keys(table, 1000, n - 1);
+
+  swiss_destroy(table);
+}
+
+
+/**
+ * Searches after the table grows many times, with hits and misses
+*/
+void test_growth() {
+  SwissHash table = swiss_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  for (int n = 0; n < 20000; n++) {
+    swiss_add(table, &n);
+    assert(swiss_stuffed(table) == n + 1);
+    assert((float) swiss_stuffed(table) / swiss_capacity(table) <= SWISS_OVERLOAD_CHARGE_FACTOR);
+  }
+  assert(swiss_capacity(table) == 32768);
+  check_keys(table, 0, 19999);
+
+  for (int n = 0; n < 20000; n += 2) swiss_delete(table, &n);
+  for (int n = 0; n < 20000; n++) assert((swiss_search(table, &n) != NULL) == n % 2);
+
+  swiss_destroy(table);
+}
+
+
+int main() {
+
+  test_wrap();
+  test_deleted();
+  test_growth();
+  puts("Checks passed\n");
+
+
+  SwissHash table = swiss_create(16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+  int n;
+
+  puts("Add 0, 3, 6, ..., 57");
+  for (n = 0; n < 60; n += 3) swiss_add(table, &n);
+  printf("Capacity: %i Stuffed: %i\n", swiss_capacity(table), swiss_stuffed(table));
+  puts("");
+
+  puts("Search 9 and 10");
+  n = 9;
+  visit_int(swiss_search(table, &n));
+  n = 10;
+  visit_int(swiss_search(table, &n));
+  puts("\n");
+
+  puts("Delete 0, 6, 12, ..., 54");
+  for (n = 0; n < 60; n += 6) swiss_delete(table, &n);
+  printf("Capacity: %i Stuffed: %i\n", swiss_capacity(table), swiss_stuffed(table));
+  puts("");
+
+  puts("Search 6 and 9");
+  n = 6;
+  visit_int(swiss_search(table, &n));
+  n = 9;
+  visit_int(swiss_search(table, &n));
+  puts("\n");
+
+  swiss_print(table);
+
+  swiss_destroy(table);
+
+  puts("");
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "hash_table.h"
+#include "int.h"
+#include <assert.h>
+
+#define KEYS 2048
+#define STEPS 50000
+
+
+/**
+ * Hash an int by its value
+*/
+unsigned hash_int(void* data) {
+  return (unsigned) *(int*) data;
+}
+
+
+/**
+ * Hash an int to the same value always (every element collides)
+*/
+unsigned hash_constant(void* data) {
+  (void) data;
+  return 42;
+}
+
+
+/**
+ * Save on type the probing type of the engine, return false if it isnt a probing engine
+*/
+int probing_type(HashEngine engine, ProbingType* type) {
+  switch (engine) {
+    case ENGINE_LINEAR: *type = LINEAR; return true;
+    case ENGINE_CUADRATIC: *type = CUADRATIC; return true;
+    case ENGINE_DOUBLE_HASHING: *type = DOUBLE_HASHING; return true;
+    case ENGINE_ROBIN_HOOD: *type = ROBIN_HOOD; return true;
+    case ENGINE_HOPSCOTCH: *type = HOPSCOTCH; return true;
+    default: return false;
+  }
+}
+
+
+/**
+ * Run the same random adds and deletes of the given amount of keys on every engine,
+ * checking after each one that all of them have the same keys as a plain array
+*/
+void check_engines(FunctionHash hash, int keys, char* title) {
+
+  Table tables[ENGINES];
+  for (HashEngine engine = 0; engine < ENGINES; engine++) {
+    tables[engine] = table_create(engine, 16, copy_int, destroy_int, compare_int, visit_int, hash);
+  }
+
+  char* present = calloc(keys, 1);
+  int stuffed = 0;
+
+  srand(keys);
+  for (int i = 0; i < STEPS; i++) {
+
+    int key = rand() % keys;
+    int add = rand() % 3 != 0;
+
+    for (HashEngine engine = 0; engine < ENGINES; engine++) {
+      if (add) table_add(tables[engine], &key);
+      else table_delete(tables[engine], &key);
+    }
+
+    stuffed += add ? not present[key] : -present[key];
+    present[key] = add;
+
+    // Search a random key in every engine
+    int other = rand() % keys;
+    for (HashEngine engine = 0; engine < ENGINES; engine++) {
+      int* found = table_search(tables[engine], &other);
+      assert(present[other] ? found and *found == other : not found);
+      assert(table_stuffed(tables[engine]) == stuffed);
+    }
+  }
+
+  printf("%s: %i keys\n", title, stuffed);
+  for (HashEngine engine = 0; engine < ENGINES; engine++) {
+    for (int key = 0; key < keys; key++) assert((table_search(tables[engine], &key) != NULL) == present[key]);
+    printf("%16s capacity %i\n", table_engine_name(engine), table_capacity(tables[engine]));
+    table_destroy(tables[engine]);
+  }
+  puts("");
+
+  free(present);
+}
+
+
+int main() {
+
+  // Each engine builds its own table
+  for (HashEngine engine = 0; engine < ENGINES; engine++) {
+
+    Table table = table_create(engine, 16, copy_int, destroy_int, compare_int, visit_int, hash_int);
+
+    assert(table->engine == engine);
+    ProbingType type;
+    if (probing_type(engine, &type)) assert(((Hash) table->table)->type == type);
+    for (HashEngine other = 0; other < engine; other++) {
+      assert(strcmp(table_engine_name(engine), table_engine_name(other)) != 0);
+    }
+
+    table_destroy(table);
+  }
+
+  // No engine, and NULL tables
+  assert(table_create(ENGINES, 16, copy_int, destroy_int, compare_int, visit_int, hash_int) == NULL);
+  assert(table_engine_name(ENGINES) == NULL);
+  assert(table_capacity(NULL) == 0 and table_stuffed(NULL) == 0 and table_search(NULL, NULL) == NULL);
+
+  check_engines(hash_int, KEYS, "Hash by value");
+
+  // Every key collides: cuadratic probing rehashes more than once, hopscotch
+  // uses its overflow and cuckoo its stash
+  check_engines(hash_constant, 300, "Same hash");
+
+  return 0;
+}
\ No newline at end of file
@@ -1,8 +1,152 @@
 #include "heap.h"
 #include "int.h"
+#include <assert.h>
+
+#define CHECK_KEYS 5000
+
+/**
+ * Pop all the elements of the heap, checking that they come out in order
+*/
+void check_pop_order(BHeap heap, int amount) {
+	
+	int previous = 0;
+	
+	for (int i = 0; i < amount; i++) {
+		
+		int top = *(int*) bheap_top(heap);
+		if (i > 0) assert(heap->type == MIN ? top >= previous : top <= previous);
+		previous = top;
+		bheap_pop(heap);
+	}
+	
+	assert(bheap_is_empty(heap) and bheap_top(heap) == NULL);
+}
+
+
+/**
+ * Check the order of heaps of the given arity, filled by adds, by adds of
+ * batches (rebuilt bottom-up) and mixed with pops
+*/
+void check_arity(int arity) {
+	
+	int values[CHECK_KEYS];
+	void* array[CHECK_KEYS];
+	
+	for (int i = 0; i < CHECK_KEYS; i++) {
+		values[i] = rand() % 1000;
+		array[i] = &values[i];
+	}
+	
+	for (PriorityType type = MAX; type <= MIN; type++) {
+		
+		// One by one
+		BHeap heap = bheap_create_arity(1, arity, type, copy_int, destroy_int, compare_int, visit_int);
+		for (int i = 0; i < CHECK_KEYS; i++) bheap_add(heap, array[i]);
+		check_pop_order(heap, CHECK_KEYS);
+		
+		// Every length of the batch (a big batch is rebuilt from the last father)
+		for (int length = 0; length < 100; length++) {
+			bheap_add_many(heap, array, length, NULL);
+			check_pop_order(heap, length);
+		}
+		
+		// A small batch after a big one, and pops between adds
+		bheap_add_many(heap, array, CHECK_KEYS, NULL);
+		bheap_add_many(heap, array, 10, NULL);
+		for (int i = 0; i < CHECK_KEYS; i++) {
+			bheap_pop(heap);
+			bheap_add(heap, array[i]);
+		}
+		check_pop_order(heap, CHECK_KEYS + 10);
+		
+		bheap_destroy(heap);
+		
+		// From an array (binary)
+		for (int length = 0; length < 100; length++) {
+			heap = bheap_create_from_array(array, length, type, copy_int, destroy_int, compare_int, visit_int);
+			check_pop_order(heap, length);
+			bheap_destroy(heap);
+		}
+	}
+}
+
+
+/**
+ * Random adds, updates and deletes by handle of a heap of the given arity, checking
+ * the top and the data of each handle against a plain array, and that the handles
+ * of the deleted elements stay stale when their slots are given again
+*/
+void check_handles(int arity) {
+	
+	BHeap heap = bheap_create_handles(1, arity, MIN, copy_int, destroy_int, compare_int, visit_int);
+	
+	// Handle, value and if its alive, of each element added
+	BHandle handles[CHECK_KEYS];
+	int values[CHECK_KEYS], alive[CHECK_KEYS];
+	int added = 0, live = 0;
+	
+	// A batch first, with its handles
+	void* array[100];
+	for (int i = 0; i < 100; i++) {
+		values[i] = rand() % 1000;
+		alive[i] = true;
+		array[i] = &values[i];
+	}
+	bheap_add_many(heap, array, 100, handles);
+	added = live = 100;
+	
+	while (added < CHECK_KEYS) {
+		
+		int i = rand() % added, operation = rand() % 3;
+		
+		// Add
+		if (operation == 0 or live == 0) {
+			values[added] = rand() % 1000;
+			alive[added] = true;
+			handles[added] = bheap_add(heap, &values[added]);
+			added++;
+			live++;
+		}
+		
+		// Update
+		else if (operation == 1 and alive[i]) {
+			values[i] = rand() % 1000;
+			bheap_update_priority(heap, handles[i], &values[i]);
+		}
+		
+		// Delete (a stale handle does nothing)
+		else if (operation == 2) {
+			bheap_delete_handle(heap, handles[i]);
+			live -= alive[i];
+			alive[i] = false;
+		}
+		
+		// The top is the minimun of the live values
+		int minimun = -1;
+		for (int k = 0; k < added; k++) {
+			if (alive[k] and (minimun == -1 or values[k] < minimun)) minimun = values[k];
+		}
+		assert(live == heap->last);
+		assert(live == 0 ? bheap_top(heap) == NULL : *(int*) bheap_top(heap) == minimun);
+	}
+	
+	for (int k = 0; k < added; k++) {
+		int* data = bheap_get(heap, handles[k]);
+		assert(alive[k] ? data and *data == values[k] : data == NULL);
+	}
+	
+	bheap_destroy(heap);
+}
+
 
 int main() {
 	
+	assert(bheap_create_arity(10, 1, MIN, copy_int, destroy_int, compare_int, visit_int) == NULL);
+	for (int arity = 2; arity <= 8; arity *= 2) check_arity(arity);
+	check_arity(3);
+	for (int arity = 2; arity <= 8; arity *= 2) check_handles(arity);
+	puts("Checks passed");
+	
 	BHeap bheap_max = bheap_create(10, MAX, copy_int, destroy_int, compare_int, visit_int);
 	BHeap bheap_min = bheap_create(10, MIN, copy_int, destroy_int, compare_int, visit_int);
 	
@@ -60,6 +204,90 @@ int main() {
 	bheap_destroy(bheap_max);
 	bheap_destroy(bheap_min);
 	
+	int values[] = {5, 3, 9, 1, 7, 4, 8};
+	void* array[] = {&values[0], &values[1], &values[2], &values[3], &values[4], &values[5], &values[6]};
+	
+	BHeap bheap_array = bheap_create_from_array(array, 5, MAX, copy_int, destroy_int, compare_int, visit_int);
+	
+	puts("");
+	puts("Heap max from 5 3 9 1 7");
+	bheap_print(bheap_array);
+	puts("");
+	
+	bheap_add_many(bheap_array, array + 5, 2, NULL);
+	
+	puts("Heap max add 4 8");
+	bheap_print(bheap_array);
+	puts("");
+	
+	bheap_destroy(bheap_array);
+	
+	BHeap bheap_grow = bheap_create(1, MIN, copy_int, destroy_int, compare_int, visit_int);
+	
+	for (n = 10; n > 0; n--) bheap_add(bheap_grow, &n);
+	assert(bheap_grow->capacity == 16 and bheap_grow->last == 10);
+	
+	puts("");
+	printf("Heap min add 10 ... 1 from capacity 1, capacity: %i\n", bheap_grow->capacity);
+	bheap_print(bheap_grow);
+	puts("");
+	
+	// Reserve only grows
+	bheap_reserve(bheap_grow, 100);
+	assert(bheap_grow->capacity == 100);
+	bheap_reserve(bheap_grow, 50);
+	assert(bheap_grow->capacity == 100 and bheap_grow->last == 10);
+	
+	bheap_pop(bheap_grow);
+	bheap_pop(bheap_grow);
+	bheap_shrink_to_fit(bheap_grow);
+	assert(bheap_grow->capacity == 8 and bheap_grow->last == 8);
+	
+	printf("Heap min pop 2 and shrink, capacity: %i\n", bheap_grow->capacity);
+	bheap_print(bheap_grow);
+	puts("");
+	
+	// Every element survives, in order
+	for (n = 3; n <= 10; n++) {
+		assert(*(int*) bheap_top(bheap_grow) == n);
+		bheap_pop(bheap_grow);
+	}
+	
+	// Shrink an empty heap, and grow it again
+	bheap_shrink_to_fit(bheap_grow);
+	assert(bheap_grow->capacity == 0 and bheap_is_empty(bheap_grow));
+	for (n = 0; n < 3; n++) bheap_add(bheap_grow, &n);
+	assert(bheap_grow->capacity >= 3 and *(int*) bheap_top(bheap_grow) == 0);
+	
+	bheap_destroy(bheap_grow);
+	
+	BHeap bheap_handles = bheap_create_handles(4, 2, MIN, copy_int, destroy_int, compare_int, visit_int);
+	
+	BHandle handles[5];
+	for (n = 0; n < 5; n++) handles[n] = bheap_add(bheap_handles, &values[n]);
+	
+	puts("");
+	puts("Heap min from 5 3 9 1 7");
+	bheap_print(bheap_handles);
+	puts("");
+	
+	n = 0;
+	bheap_update_priority(bheap_handles, handles[2], &n);
+	bheap_delete_handle(bheap_handles, handles[3]);
+	
+	puts("Heap min update 9 to 0 and delete 1 by their handles");
+	bheap_print(bheap_handles);
+	puts("");
+	
+	n = 6;
+	bheap_add(bheap_handles, &n);
+	
+	printf("Heap min add 6, data of the handle of 1: ");
+	visit_int(bheap_get(bheap_handles, handles[3]));
+	puts("");
+	
+	bheap_destroy(bheap_handles);
+	
 	puts("");
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "heap_key.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define CHECK_KEYS 5000
+
+
+/**
+ * Integer keys of the checks: random ones, and the ones at both ends
+*/
+uint64_t random_key(int i) {
+  if (i % 10 == 0) return UINT64_MAX - i / 10 % 3;
+  if (i % 10 == 1) return i / 10 % 3;
+  return (uint64_t) rand() << 40 ^ (uint64_t) rand() << 20 ^ rand();
+}
+
+
+/**
+ * Pop all the integer keys, checking that they come out in order, each one with its payload,
+ * starting from capacity 1 (so the array grows)
+*/
+void check_keys(PriorityType type) {
+  KHeap heap = kheap_create(1, type);
+  uint64_t keys[CHECK_KEYS];
+
+  for (int i = 0; i < CHECK_KEYS; i++) {
+    keys[i] = random_key(i);
+    kheap_add(heap, keys[i], &keys[i]);
+  }
+  assert(kheap_size(heap) == CHECK_KEYS and heap->capacity >= CHECK_KEYS);
+
+  uint64_t previous = type == MIN ? 0 : UINT64_MAX;
+  for (int i = 0; i < CHECK_KEYS; i++) {
+    uint64_t key = kheap_top_key(heap);
+    assert(type == MIN ? key >= previous : key <= previous);
+    assert(*(uint64_t*) kheap_top(heap) == key);
+    previous = key;
+    kheap_pop(heap);
+  }
+  assert(previous == (type == MIN ? UINT64_MAX : 0));
+
+  // Empty
+  assert(kheap_is_empty(heap) and kheap_top(heap) == NULL and kheap_top_key(heap) == 0);
+  assert(kheap_top_key_double(heap) == 0);
+  kheap_pop(heap);
+  assert(kheap_size(heap) == 0);
+
+  kheap_destroy(heap);
+}
+
+
+/**
+ * Pop all the double keys, with negatives and both zeros, checking that they come out
+ * in order (-0 before 0 in a heap min) and unchanged
+*/
+void check_doubles(PriorityType type) {
+  KHeap heap = kheap_create(1, type);
+  double keys[] = {2.5, -1.25, 0.0, -0.0, 10.75, -3, 1e300, -1e300, 1e-300, -1e-300, INFINITY, -INFINITY};
+  int amount = sizeof(keys) / sizeof(keys[0]);
+
+  for (int i = 0; i < amount; i++) kheap_add_double(heap, keys[i], &keys[i]);
+
+  double previous = type == MIN ? -INFINITY : INFINITY;
+  for (int i = 0; i < amount; i++) {
+    double key = kheap_top_key_double(heap);
+    assert(type == MIN ? key >= previous : key <= previous);
+
+    // Between the zeros, the sign tells the order
+    if (key == 0 and previous == 0 and i > 0) assert(type == MIN ? not signbit(key) : signbit(key));
+
+    assert(*(double*) kheap_top(heap) == key and signbit(*(double*) kheap_top(heap)) == signbit(key));
+    previous = key;
+    kheap_pop(heap);
+  }
+  assert(kheap_is_empty(heap));
+
+  kheap_destroy(heap);
+}
+
+
+int main() {
+
+  srand(1);
+  check_keys(MIN);
+  check_keys(MAX);
+  check_doubles(MIN);
+  check_doubles(MAX);
+  puts("Checks passed\n");
+
+  char* names[] = {"five", "three", "nine", "one", "seven"};
+  uint64_t keys[] = {5, 3, 9, 1, 7};
+
+  KHeap heap = kheap_create(2, MIN);
+
+  puts("Heap min add 5 3 9 1 7");
+  for (int i = 0; i < 5; i++) kheap_add(heap, keys[i], names[i]);
+  kheap_print(heap);
+  puts("");
+
+  puts("Pop all");
+  while (not kheap_is_empty(heap)) {
+    printf("%llu %s\n", (unsigned long long) kheap_top_key(heap), (char*) kheap_top(heap));
+    kheap_pop(heap);
+  }
+  puts("");
+
+  kheap_destroy(heap);
+
+  double times[] = {2.5, -1.25, 0, 10.75, -3};
+
+  heap = kheap_create(2, MAX);
+
+  puts("Heap max add 2.5 -1.25 0 10.75 -3");
+  for (int i = 0; i < 5; i++) kheap_add_double(heap, times[i], NULL);
+
+  puts("Pop all");
+  while (not kheap_is_empty(heap)) {
+    printf("%g ", kheap_top_key_double(heap));
+    kheap_pop(heap);
+  }
+  puts("");
+
+  kheap_destroy(heap);
+
+  puts("");
+  return 0;
+}
\ No newline at end of file
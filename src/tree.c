@@ -1,4 +1,5 @@
 #include "tree.h"
+#include <stddef.h>
 
 
 /**
@@ -14,6 +15,84 @@
 */
 
 
+/**
+ * Built in stack of nodes to travel the trees without recursion
+*/
+typedef struct _NStack {
+
+  void* *nodes;
+  int last;
+  int capacity;
+
+} *NStack;
+
+
+/**
+ * Initial capacity of the stack of nodes
+*/
+#define NSTACK_CAPACITY 64
+
+
+/**
+ * Create an empty stack of nodes
+*/
+NStack nstack_create() {
+
+    NStack newStack = malloc(sizeof(struct _NStack));
+
+    newStack->capacity = NSTACK_CAPACITY;
+    newStack->last = -1;
+    newStack->nodes = malloc(sizeof(void*) * newStack->capacity);
+
+    return newStack;
+}
+
+
+/**
+ * Destroy the stack of nodes (not the nodes)
+*/
+void nstack_destroy(NStack stack) {
+
+    if (not stack) return;
+
+    free(stack->nodes);
+    free(stack);
+}
+
+
+/**
+ * Check if the stack of nodes is empty, return true if it is, false otherwise
+*/
+int nstack_is_empty(NStack stack) { return stack->last == -1; }
+
+
+/**
+ * Push some node in the stack, double its capacity if its full
+*/
+void nstack_push(NStack stack, void* node) {
+
+    if (stack->last + 1 == stack->capacity) {
+
+        stack->capacity *= 2;
+        stack->nodes = realloc(stack->nodes, sizeof(void*) * stack->capacity);
+    }
+
+    stack->nodes[++stack->last] = node;
+}
+
+
+/**
+ * Return the node at the top of the stack
+*/
+void* nstack_top(NStack stack) { return stack->nodes[stack->last]; }
+
+
+/**
+ * Pop the node at the top of the stack and return it
+*/
+void* nstack_pop(NStack stack) { return stack->nodes[stack->last--]; }
+
+
 /**
  * Binary tree
 */
@@ -44,38 +123,134 @@ BTree btree_union(void* data, BTree left, BTree right, FunctionCopy copy) {
 */
 void btree_destroy(BTree tree, FunctionDestroy destroy) {
 
-    if (not tree) return;
+    // Rotate the left subtrees up, so the root never has a left subtree
+    // when its freed (no recursion and no extra memory)
+    while (tree exist) {
 
-    btree_destroy(tree->left, destroy);
-    btree_destroy(tree->right, destroy);
-    
-    destroy(tree->data);
-    free(tree);
+        // Rotation to the right
+        if (tree->left exist) {
+
+            BTree left = tree->left;
+            tree->left = left->right;
+            left->right = tree;
+            tree = left;
+        }
+
+        // Free the root and keep with the right subtree
+        else {
+
+            BTree right = tree->right;
+            destroy(tree->data);
+            free(tree);
+            tree = right;
+        }
+    }
 }
 
 
 /**
- * Travel through the binary tree in some order
+ * Data, left and right subtrees of a node of any binary tree, given the offsets
+ * of its subtrees (the data is always the first field)
 */
-void btree_travel(BTree tree, BTreeOrder order, FunctionVisit visit) {
+#define NODE_DATA(node) (*(void* *) (node))
+#define NODE_LEFT(node) (*(void* *) ((char*) (node) + left))
+#define NODE_RIGHT(node) (*(void* *) ((char*) (node) + right))
+
+
+/**
+ * Travel through a tree of any binary node type in some order,
+ * left and right are the offsets of the subtrees in the node
+*/
+void node_travel(void* tree, size_t left, size_t right, BTreeOrder order, FunctionVisit visit) {
 
     if (not tree) return;
 
+    // Nodes left to travel
+    NStack stack = nstack_create();
+    void* node = tree, *last = NULL;
+
     // Preorder
-    if (order == PRE) 
-        visit(tree->data);
+    if (order == PRE) {
+
+        while (node exist) {
+
+            visit(NODE_DATA(node));
+
+            // The right subtree goes after the left one
+            if (NODE_RIGHT(node) exist) 
+                nstack_push(stack, NODE_RIGHT(node));
+
+            node = NODE_LEFT(node);
+
+            if (not node and not nstack_is_empty(stack)) 
+                node = nstack_pop(stack);
+        }
+    }
 
-    btree_travel(tree->left, order, visit);
-    
     // Inorder
-    if (order == IN) 
-        visit(tree->data);
-    
-    btree_travel(tree->right, order, visit);
-    
-    // Postorder
-    if (order == POST) 
-        visit(tree->data);
+    else if (order == IN) {
+
+        while (node exist or not nstack_is_empty(stack)) {
+
+            // Go down through the left subtree
+            if (node exist) {
+
+                nstack_push(stack, node);
+                node = NODE_LEFT(node);
+            }
+
+            // Then visit the father and go down through the right subtree
+            else {
+
+                node = nstack_pop(stack);
+                visit(NODE_DATA(node));
+                node = NODE_RIGHT(node);
+            }
+        }
+    }
+
+    // Postorder (the stack keeps the path from the root to the current node)
+    else {
+
+        while (node exist or not nstack_is_empty(stack)) {
+
+            // Go down through the left subtree
+            if (node exist) {
+
+                nstack_push(stack, node);
+                node = NODE_LEFT(node);
+            }
+
+            else {
+
+                void* top = nstack_top(stack);
+
+                // Coming back from the left subtree, go down through the right one
+                if (NODE_RIGHT(top) exist and NODE_RIGHT(top) != last) {
+
+                    node = NODE_RIGHT(top);
+                }
+
+                // Both subtrees were travelled
+                else {
+
+                    visit(NODE_DATA(top));
+                    last = nstack_pop(stack);
+                }
+            }
+        }
+    }
+
+    nstack_destroy(stack);
+}
+
+
+/**
+ * Travel through the binary tree in some order
+*/
+void btree_travel(BTree tree, BTreeOrder order, FunctionVisit visit) {
+
+    node_travel(tree, offsetof(struct _BTNode, left), offsetof(struct _BTNode, right), order, visit);
 }
 
 
@@ -86,10 +261,44 @@ int btree_height(BTree tree) {
 
     if (not tree) return -1;
 
-    int leftHeight = 1 + btree_height(tree->left);
-    int rightHeight = 1 + btree_height(tree->right);
+    // Path from the root to the current node, the height is its longest length
+    NStack stack = nstack_create();
+    BTree node = tree, last = NULL;
+    int height = -1;
+
+    while (node exist or not nstack_is_empty(stack)) {
+
+        // Go down through the left subtree
+        if (node exist) {
+
+            nstack_push(stack, node);
+            node = node->left;
+
+            if (stack->last > height) 
+                height = stack->last;
+        }
 
-    return leftHeight > rightHeight ? leftHeight : rightHeight;
+        else {
+
+            BTree top = nstack_top(stack);
+
+            // Coming back from the left subtree, go down through the right one
+            if (top->right exist and top->right != last) {
+
+                node = top->right;
+            }
+
+            // Both subtrees were travelled
+            else {
+
+                last = nstack_pop(stack);
+            }
+        }
+    }
+
+    nstack_destroy(stack);
+
+    return height;
 }
 
 
@@ -100,23 +309,32 @@ int btree_search_bool(BTree tree, void* data, FunctionCompare compare) {
 
     if (not tree) return false;
 
-    // Search in the root
-    if(compare(data, tree->data) == 0) {
+    // Nodes left to search in
+    NStack stack = nstack_create();
+    nstack_push(stack, tree);
 
-        return true;
-    }
+    int found = false;
+    while (not found and not nstack_is_empty(stack)) {
 
-    // Search in the left subtree
-    else if (btree_search_bool(tree->left, data, compare) == true) {
+        BTree node = nstack_pop(stack);
 
-        return true;
-    }
+        // Search in the root
+        if (compare(data, node->data) == 0) {
 
-    // Search in the right subtree
-    else {
+            found = true;
+        }
+
+        // Then in the left subtree and then in the right subtree
+        else {
 
-        return btree_search_bool(tree->right, data, compare);
+            if (node->right exist) nstack_push(stack, node->right);
+            if (node->left exist) nstack_push(stack, node->left);
+        }
     }
+
+    nstack_destroy(stack);
+
+    return found;
 }
 
 
@@ -136,6 +354,7 @@ BST bst_create(FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compa
     newTree->destroy = destroy;
     newTree->compare = compare;
     newTree->visit = visit;
+    newTree->compares = 0;
 
     return newTree;
 }
@@ -144,29 +363,39 @@ BST bst_create(FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compa
 /**
  * Return a binary search tree after insert data
 */
-BTree bst_add_aux(BTree tree, void* data, FunctionCopy copy, FunctionCompare compare) {
+BTree bst_add_aux(BTree tree, void* data, FunctionCopy copy, FunctionCompare compare, int* compares) {
 
-    if (not tree) {
+    // Link of the tree where data must be
+    BTree* link = &tree;
 
-        return btree_union(data, NULL, NULL, copy);
-    }
+    while (*link exist) {
 
-    // If data is greater
-    if (compare(data, tree->data) > 0) {
+        // Compare only once per node
+        int comparation = compare(data, (*link)->data);
+        (*compares)++;
 
-        tree->right = bst_add_aux(tree->right, data, copy, compare);
-        return tree;
-    }
-    
-    // If data is lower
-    else if (compare(data, tree->data) < 0) {
+        // If data is greater
+        if (comparation > 0) {
 
-        tree->left = bst_add_aux(tree->left, data, copy, compare);
-        return tree;
+            link = &(*link)->right;
+        }
+
+        // If data is lower
+        else if (comparation < 0) {
+
+            link = &(*link)->left;
+        }
+
+        // Otherwise data is equal
+        // If data already exist in the tree, do nothing
+        else {
+
+            return tree;
+        }
     }
 
-    // Otherwise data is equal
-    // If data already exist in the tree, do nothing
+    *link = btree_union(data, NULL, NULL, copy);
+
     return tree;
 }
 
@@ -178,7 +407,8 @@ void bst_add(BST tree, void* data) {
 
     if (not tree) return;
 
-    tree->root = bst_add_aux(tree->root, data, tree->copy, tree->compare);
+    tree->compares = 0;
+    tree->root = bst_add_aux(tree->root, data, tree->copy, tree->compare, &tree->compares);
 }
 
 
@@ -197,29 +427,34 @@ void bst_destroy(BST tree) {
 /**
  * Search data in the binary search tree, return true if finds it and false otherwise
 */
-int bst_search_aux_bool(BTree tree, void* data, FunctionCompare compare) {
+int bst_search_aux_bool(BTree tree, void* data, FunctionCompare compare, int* compares) {
 
-    if (not tree) return false;
+    while (tree exist) {
 
-    // If data is greater
-    if (compare(data, tree->data) > 0) {
+        // Compare only once per node
+        int comparation = compare(data, tree->data);
+        (*compares)++;
 
-        // Only search in the right subtree
-        return bst_search_aux_bool(tree->right, data, compare);
-    }
+        // If data is greater, only search in the right subtree
+        if (comparation > 0) {
 
-    // If data is lower
-    else if (compare(data, tree->data) < 0) {
+            tree = tree->right;
+        }
 
-        // Only search in the right subtree
-        return bst_search_aux_bool(tree->left, data, compare);
-    }
+        // If data is lower, only search in the left subtree
+        else if (comparation < 0) {
 
-    // Otherwise data is equal
-    else {
+            tree = tree->left;
+        }
 
-        return true;
+        // Otherwise data is equal
+        else {
+
+            return true;
+        }
     }
+
+    return false;
 }
 
 
@@ -230,7 +465,8 @@ int bst_search_bool(BST tree, void* data) {
 
     if (not tree) return false;
 
-    return bst_search_aux_bool(tree->root, data, tree->compare);
+    tree->compares = 0;
+    return bst_search_aux_bool(tree->root, data, tree->compare, &tree->compares);
 }
 
 
@@ -256,89 +492,94 @@ BTree previous_max_of_min(BTree tree) {
 /**
  * Delete data from the binary search tree if exist on it
 */
-BTree bst_delete_aux(BTree tree, void* data, FunctionCompare compare, FunctionDestroy destroy) {
+BTree bst_delete_aux(BTree tree, void* data, FunctionCompare compare, FunctionDestroy destroy, int* compares) {
 
-    if (not tree) return NULL;
+    // Link of the tree where data may be
+    BTree* link = &tree;
 
-    // If data is greater
-    if (compare(data, tree->data) > 0) {
+    while (*link exist) {
 
-        // Only search in the right subtree
-        tree->right = bst_delete_aux(tree->right, data, compare, destroy);
-        return tree;
-    }
+        // Compare only once per node
+        int comparation = compare(data, (*link)->data);
+        (*compares)++;
 
-    // If data is lower
-    if (compare(data, tree->data) < 0) {
+        // If data is greater, only search in the right subtree
+        if (comparation > 0) {
 
-        // Only search in the left subtree
-        tree->left = bst_delete_aux(tree->left, data, compare, destroy);
-        return tree;
-    }
+            link = &(*link)->right;
+        }
 
-    // Otherwise data is equal
-    else {
+        // If data is lower, only search in the left subtree
+        else if (comparation < 0) {
 
-        // If it has no subtrees
-        if(not tree->left and not tree->right) {
+            link = &(*link)->left;
+        }
 
-            destroy(tree->data);
-            free(tree);
-            return NULL;
+        // Otherwise data is equal
+        else {
+
+            break;
         }
+    }
 
-        // If only have a right subtree
-        else if (tree->right exist and not tree->left) {
+    // Data doesnt exist in the tree
+    if (not *link) return tree;
 
-            // Node to delete data and relink the right subtree
-            BTree node = tree;
-            tree = tree->right;
-            destroy(node->data);
-            free(node);
+    BTree node = *link;
 
-            return tree;
-        }
+    // If it has no subtrees
+    if (not node->left and not node->right) {
 
-        // If only have a left subtree
-        else if (tree->left exist and not tree->right) {
+        destroy(node->data);
+        free(node);
+        *link = NULL;
+    }
 
-            // Node to delete data and relink the left subtree
-            BTree node = tree;
-            tree = tree->left;
-            destroy(node->data);
-            free(node);
+    // If only have a right subtree
+    else if (node->right exist and not node->left) {
 
-            return tree;
-        }
+        // Relink the right subtree
+        *link = node->right;
+        destroy(node->data);
+        free(node);
+    }
 
-        // Has both subtrees
-        else {
-            
-            // Search the previous node to the maximun of the minimuns
-            destroy(tree->data);
-            BTree previousMaxMin = previous_max_of_min(tree);
-
-            // If its the inmediate left
-            if(not previousMaxMin->right) {
-                
-                tree->data = previousMaxMin->data;
-                tree->left = previousMaxMin->left;
-                free(previousMaxMin);
-            }
+    // If only have a left subtree
+    else if (node->left exist and not node->right) {
 
-            // Swap data
-            else {
+        // Relink the left subtree
+        *link = node->left;
+        destroy(node->data);
+        free(node);
+    }
 
-                // Node to delete data and relink
-                BTree node = previousMaxMin->right;
-                tree->data = node->data;
-                previousMaxMin->right = previousMaxMin->right->left;
-                free(node);
-            }
+    // Has both subtrees
+    else {
 
-            return tree;
+        // Search the previous node to the maximun of the minimuns
+        destroy(node->data);
+        BTree previousMaxMin = previous_max_of_min(node);
+
+        // If its the inmediate left
+        if (not previousMaxMin->right) {
+
+            node->data = previousMaxMin->data;
+            node->left = previousMaxMin->left;
+            free(previousMaxMin);
+        }
+
+        // Swap data
+        else {
+
+            // Node to delete data and relink
+            BTree maxMin = previousMaxMin->right;
+            node->data = maxMin->data;
+            previousMaxMin->right = maxMin->left;
+            free(maxMin);
         }
     }
+
+    return tree;
 }
 
 
@@ -349,10 +590,17 @@ void bst_delete(BST tree, void* data) {
 
     if (not tree) return;
 
-    tree->root = bst_delete_aux(tree->root, data, tree->compare, tree->destroy);
+    tree->compares = 0;
+    tree->root = bst_delete_aux(tree->root, data, tree->compare, tree->destroy, &tree->compares);
 }
 
 
+/**
+ * Return the amount of compares made by the last add, search or delete
+*/
+int bst_compares(BST tree) { return tree->compares; }
+
+
 /**
  * Travel the binary search tree in some order
 */
@@ -369,35 +617,28 @@ void bst_travel(BST tree, BTreeOrder order) {
 */
 
 /**
- * Return the node which is the previous one to the maximun of 
- * the minimuns from the given node
+ * Return the height of the AVL tree
+ * (read from the node, it is kept updated on every add and delete)
 */
-ATree avl_previous_max_of_min(ATree tree) {
-
-    if (not tree) return NULL;
-    if(not tree->left) return NULL;
-
-    // From the minimun
-    tree = tree->left;
+int avl_height(ATree tree) {
 
-    // The maximun
-    for(; tree->right != NULL and tree->right->right != NULL; tree = tree->right);
+    if (not tree) return 0;
 
-    return tree;
+    return tree->height;
 }
 
 
 /**
- * Return the height of the AVL tree
+ * Update the height of the node from the heights of its subtrees
 */
-int avl_height(ATree tree) {
+void avl_update_height(ATree tree) {
 
-    if (not tree) return 0;
+    if (not tree) return;
 
-    int left = 1 + avl_height(tree->left);
-    int right = 1 + avl_height(tree->right);
+    int left = avl_height(tree->left);
+    int right = avl_height(tree->right);
 
-    return left > right ? left : right;
+    tree->height = 1 + (left > right ? left : right);
 }
 
 
@@ -424,8 +665,9 @@ ATree avl_rotation_left(ATree tree) {
     tree->right = rightSubtree->left;
     rightSubtree->left = tree;
 
-    rightSubtree->height = avl_height(rightSubtree);
-    tree->height = avl_height(tree);
+    // The old root is now below, so update it first
+    avl_update_height(tree);
+    avl_update_height(rightSubtree);
 
     return rightSubtree;
 }
@@ -443,8 +685,9 @@ ATree avl_rotation_right(ATree tree) {
     tree->left = leftSubtree->right;
     leftSubtree->right = tree;
 
-    leftSubtree->height = avl_height(leftSubtree);
-    tree->height = avl_height(tree);
+    // The old root is now below, so update it first
+    avl_update_height(tree);
+    avl_update_height(leftSubtree);
 
     return leftSubtree;
 }
@@ -461,7 +704,7 @@ int avl_check(ATree tree) {
     if (abs(avl_balance_factor(tree)) > 1) return false;
 
     // Check both subtrees
-    return avl_check(tree->left) and avl_check(tree->left);
+    return avl_check(tree->left) and avl_check(tree->right);
 }
 
 
@@ -477,7 +720,7 @@ ATree avl_fix(ATree tree) {
     if (avl_height(tree->left) > avl_height(tree->right)) {
 
         // Fix outside left
-        if (avl_height(tree->left->left) > avl_height(tree->left->right)) {
+        if (avl_height(tree->left->left) >= avl_height(tree->left->right)) {
 
             // Simple rotation
             tree = avl_rotation_right(tree);
@@ -496,7 +739,7 @@ ATree avl_fix(ATree tree) {
     else {
 
         // Fix outside right
-        if (avl_height(tree->right->right) > avl_height(tree->right->left)) {
+        if (avl_height(tree->right->right) >= avl_height(tree->right->left)) {
 
             // Simple rotation
             tree = avl_rotation_left(tree);
@@ -515,6 +758,27 @@ ATree avl_fix(ATree tree) {
 }
 
 
+/**
+ * Update the height of the node and fix it if its not balanced
+*/
+ATree avl_rebalance(ATree tree) {
+
+    if (not tree) return NULL;
+
+    // Update height
+    avl_update_height(tree);
+
+    // If its not balanced
+    if (abs(avl_balance_factor(tree)) > 1) {
+
+        // Fix with the proper rotation
+        tree = avl_fix(tree);
+    }
+
+    return tree;
+}
+
+
 /**
  * Create an empty AVL search tree
 */
@@ -528,6 +792,7 @@ AVL avl_create(FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compa
     newTree->compare = compare;
     newTree->destroy = destroy;
     newTree->visit = visit;
+    newTree->compares = 0;
 
     return newTree;
 }
@@ -536,7 +801,7 @@ AVL avl_create(FunctionCopy copy, FunctionDestroy destroy, FunctionCompare compa
 /**
  * Insert data in the AVL tree
 */
-ATree avl_add_aux(ATree tree, void* data, FunctionCopy copy, FunctionCompare compare) {
+ATree avl_add_aux(ATree tree, void* data, FunctionCopy copy, FunctionCompare compare, int* compares) {
 
     if (not tree) {
 
@@ -551,42 +816,28 @@ ATree avl_add_aux(ATree tree, void* data, FunctionCopy copy, FunctionCompare com
         return newNode;
     }
 
+    // Compare only once per node
+    int comparation = compare(data, tree->data);
+    (*compares)++;
+
     // Check if needs to insert in the right subtree
-    if (compare(data, tree->data) > 0) {
+    if (comparation > 0) {
 
         // Try to insert in the right subtree
-        tree->right = avl_add_aux(tree->right, data, copy, compare);
-
-        // Update height
-        tree->height = avl_height(tree);
-
-        // If its not balanced
-        if (abs(avl_balance_factor(tree)) > 1) {
-
-            // Fix with the proper rotation
-            tree = avl_fix(tree);
-        }
+        tree->right = avl_add_aux(tree->right, data, copy, compare, compares);
 
-        return tree;
+        // Update height and balance
+        return avl_rebalance(tree);
     }
     
     // Check if needs to insert in the left subtree
-    else if (compare(data, tree->data) < 0) {
+    else if (comparation < 0) {
 
         // Try to insert in the left subtree
-        tree->left = avl_add_aux(tree->left, data, copy, compare);
+        tree->left = avl_add_aux(tree->left, data, copy, compare, compares);
 
-        // Update height
-        tree->height = avl_height(tree);
-
-        // If its not balanced
-        if (abs(avl_balance_factor(tree)) > 1) {
-
-            // Fix with the proper rotation
-            tree = avl_fix(tree);
-        }
-
-        return tree;
+        // Update height and balance
+        return avl_rebalance(tree);
     }
 
     // If data already exist in the tree, do nothing
@@ -602,7 +853,8 @@ void avl_add(AVL tree, void* data) {
     if (not tree) return;
 
     // Insert data
-    tree->root = avl_add_aux(tree->root, data, tree->copy, tree->compare);
+    tree->compares = 0;
+    tree->root = avl_add_aux(tree->root, data, tree->copy, tree->compare, &tree->compares);
 }
 
 
@@ -611,13 +863,28 @@ void avl_add(AVL tree, void* data) {
 */
 void avl_destroy_aux(ATree tree, FunctionDestroy destroy) {
 
-    if (not tree) return;
+    // Rotate the left subtrees up, so the root never has a left subtree
+    // when its freed (no recursion and no extra memory)
+    while (tree exist) {
 
-    avl_destroy_aux(tree->left, destroy);
-    avl_destroy_aux(tree->right, destroy);
+        // Rotation to the right (heights dont matter anymore)
+        if (tree->left exist) {
 
-    destroy(tree->data);
-    free(tree);
+            ATree left = tree->left;
+            tree->left = left->right;
+            left->right = tree;
+            tree = left;
+        }
+
+        // Free the root and keep with the right subtree
+        else {
+
+            ATree right = tree->right;
+            destroy(tree->data);
+            free(tree);
+            tree = right;
+        }
+    }
 }
 
 
@@ -636,29 +903,34 @@ void avl_destroy(AVL tree) {
 /**
  * Search data in the AVL tree, return true if finds it and false otherwise
 */
-int avl_search_bool_aux(ATree tree, void* data, FunctionCompare compare) {
+int avl_search_bool_aux(ATree tree, void* data, FunctionCompare compare, int* compares) {
 
-    if (not tree) return false;
+    while (tree exist) {
 
-    // Check if needs to search in the right subtree
-    if (compare(data, tree->data) > 0) {
+        // Compare only once per node
+        int comparation = compare(data, tree->data);
+        (*compares)++;
 
-        // Search in the right subtree
-        return avl_search_bool_aux(tree->right, data, compare);
-    }
+        // Check if needs to search in the right subtree
+        if (comparation > 0) {
 
-    // Check if needs to search in the left subtree
-    else if (compare(data, tree->data) < 0) {
+            tree = tree->right;
+        }
 
-        // Search in the left subtree
-        return avl_search_bool_aux(tree->left, data, compare);
-    }
+        // Check if needs to search in the left subtree
+        else if (comparation < 0) {
 
-    // Data found
-    else {
+            tree = tree->left;
+        }
+
+        // Data found
+        else {
 
-        return true;
+            return true;
+        }
     }
+
+    return false;
 }
 
 
@@ -669,52 +941,65 @@ int avl_search_bool(AVL tree, void* data) {
 
     if (not tree) return false;
 
-    return avl_search_bool_aux(tree->root, data, tree->compare);
+    tree->compares = 0;
+    return avl_search_bool_aux(tree->root, data, tree->compare, &tree->compares);
 }
 
 /**
- * Delete data from the AVL tree if exist in it
+ * Unlink the maximun node of the AVL tree, save its data and free the node
+ * Return the AVL tree balanced again
 */
-ATree avl_delete_aux(ATree tree, void* data, FunctionCompare compare, FunctionDestroy destroy) {
+ATree avl_take_max(ATree tree, void** data) {
 
     if (not tree) return NULL;
 
-    // Check if needs to delete in the right subtree
-    if (compare(data, tree->data) > 0) {
+    // The maximun has no right subtree
+    if (not tree->right) {
 
-        // Try to delete in the right subtree
-        tree->right = avl_delete_aux(tree->right, data, compare, destroy);
+        // Relink the left subtree
+        ATree left = tree->left;
+        *data = tree->data;
+        free(tree);
 
-        // Update height
-        tree->height = avl_height(tree);
+        return left;
+    }
 
-        // If its not balanced
-        if (abs(avl_balance_factor(tree)) > 1) {
+    tree->right = avl_take_max(tree->right, data);
 
-            // Fix with the proper rotation
-            tree = avl_fix(tree);
-        }
+    // Update height and balance
+    return avl_rebalance(tree);
+}
 
-        return tree;
-    }
 
-    // Check if needs to delete in the left subtree
-    if (compare(data, tree->data) < 0) {
+/**
+ * Delete data from the AVL tree if exist in it
+*/
+ATree avl_delete_aux(ATree tree, void* data, FunctionCompare compare, FunctionDestroy destroy, int* compares) {
 
-        // Try to delete in the left subtree
-        tree->left = avl_delete_aux(tree->left, data, compare, destroy);
+    if (not tree) return NULL;
 
-        // Update height
-        tree->height = avl_height(tree);
+    // Compare only once per node
+    int comparation = compare(data, tree->data);
+    (*compares)++;
 
-        // If its not balanced
-        if (abs(avl_balance_factor(tree)) > 1) {
+    // Check if needs to delete in the right subtree
+    if (comparation > 0) {
 
-            // Fix with the proper rotation
-            tree = avl_fix(tree);
-        }
+        // Try to delete in the right subtree
+        tree->right = avl_delete_aux(tree->right, data, compare, destroy, compares);
+
+        // Update height and balance
+        return avl_rebalance(tree);
+    }
+
+    // Check if needs to delete in the left subtree
+    if (comparation < 0) {
+
+        // Try to delete in the left subtree
+        tree->left = avl_delete_aux(tree->left, data, compare, destroy, compares);
 
-        return tree;
+        // Update height and balance
+        return avl_rebalance(tree);
     }
 
     // Data found
@@ -755,26 +1040,12 @@ ATree avl_delete_aux(ATree tree, void* data, FunctionCompare compare, FunctionDe
         // Has both subtrees
         else {
             
+            // Replace data with the maximun of the minimuns
             destroy(tree->data);
-            ATree previousMaxMin = avl_previous_max_of_min(tree);
-
-            if(not previousMaxMin->right) {
-                
-                tree->data = previousMaxMin->data;
-                tree->left = previousMaxMin->left;
-                free(previousMaxMin);
-            }
+            tree->left = avl_take_max(tree->left, &tree->data);
 
-            else {
-
-                // Node to delete data and relink
-                ATree node = previousMaxMin->right;
-                tree->data = node->data;
-                previousMaxMin->right = previousMaxMin->right->left;
-                free(node);
-            }
-
-            return tree;
+            // Update height and balance
+            return avl_rebalance(tree);
         }
     }
 }
@@ -788,33 +1059,15 @@ void avl_delete(AVL tree, void* data) {
     if (not tree) return;
 
     // Delete data
-    tree->root = avl_delete_aux(tree->root, data, tree->compare, tree->destroy);
+    tree->compares = 0;
+    tree->root = avl_delete_aux(tree->root, data, tree->compare, tree->destroy, &tree->compares);
 }
 
 
 /**
- * Print the AVL tree
+ * Return the amount of compares made by the last add, search or delete
 */
-void avl_travel_aux(ATree tree, BTreeOrder order, FunctionVisit visit) {
-
-    if (not tree) return;
-
-    // Preorder
-    if (order == PRE) 
-        visit(tree->data);
-
-    avl_travel_aux(tree->left, order, visit);
-    
-    // Inorder
-    if (order == IN) 
-        visit(tree->data);
-    
-    avl_travel_aux(tree->right, order, visit);
-    
-    // Postorder
-    if (order == POST) 
-        visit(tree->data);
-}
+int avl_compares(AVL tree) { return tree->compares; }
 
 
 /**
@@ -824,7 +1077,7 @@ void avl_travel(AVL tree, BTreeOrder order) {
 
     if (not tree) return;
 
-    avl_travel_aux(tree->root, order, tree->visit);
+    node_travel(tree->root, offsetof(struct _ATree, left), offsetof(struct _ATree, right), order, tree->visit);
 }
 
 
@@ -854,13 +1107,28 @@ GTree gtree_create(FunctionCopy copy, FunctionDestroy destroy, FunctionCompare c
 */
 void gtree_destroy_aux(GNode tree, FunctionDestroy destroy) {
 
-    if (not tree) return;
+    // Childs and brothers make a binary tree, so rotate the childs up
+    // till the root has no childs, then free it and keep with its brothers
+    while (tree exist) {
 
-    gtree_destroy_aux(tree->child, destroy);
-    gtree_destroy_aux(tree->brother, destroy);
-    
-    destroy(tree->data);
-    free(tree);
+        // Rotation to the right
+        if (tree->child exist) {
+
+            GNode child = tree->child;
+            tree->child = child->brother;
+            child->brother = tree;
+            tree = child;
+        }
+
+        // Free the root and keep with its brothers
+        else {
+
+            GNode brother = tree->brother;
+            destroy(tree->data);
+            free(tree);
+            tree = brother;
+        }
+    }
 }
 
 
@@ -884,23 +1152,45 @@ void gtree_print_aux(GNode tree, FunctionVisit visit) {
     if (not tree) return;
     if (not tree->child) return;
 
-    // Print the father
-    visit(tree->data);
-    printf("- ");
+    // Each element of the stack is the next child to print of some father
+    NStack stack = nstack_create();
 
-    // Print all the childs
-    for (GNode kid = tree->child; kid exist; kid = kid->brother) {
+    // Print the father and all the childs
+    // Then for each child, do the same
+    for (GNode father = tree; father exist; ) {
 
-        visit(kid->data);
-    }
-    puts("");
+        if (father->child exist) {
 
-    // Then for each child, do the same
-    for (GNode kid = tree->child; kid exist; kid = kid->brother) {
+            // Print the father
+            visit(father->data);
+            printf("- ");
 
-        gtree_print_aux(kid, visit);
+            // Print all the childs
+            for (GNode kid = father->child; kid exist; kid = kid->brother) {
+
+                visit(kid->data);
+            }
+            puts("");
+
+            nstack_push(stack, father->child);
+        }
+
+        // Take the next child to do the same
+        father = NULL;
+        while (not father and not nstack_is_empty(stack)) {
+
+            GNode kid = nstack_pop(stack);
+
+            if (kid exist) {
+
+                // Its brother goes next
+                nstack_push(stack, kid->brother);
+                father = kid;
+            }
+        }
     }
 
+    nstack_destroy(stack);
 }
 
 
@@ -85,6 +85,8 @@ typedef struct _BST {
   FunctionCompare compare;
   FunctionVisit visit;
 
+  int compares; /* Compares made by the last operation */
+
 } *BST;
 
 
@@ -109,7 +111,7 @@ void bst_destroy(BST);
 /**
  * Search data in the binary search tree, return true if finds it and false otherwise
 */
-int bst_search(BST, void*);
+int bst_search_bool(BST, void*);
 
 
 /**
@@ -118,6 +120,12 @@ int bst_search(BST, void*);
 void bst_delete(BST, void*);
 
 
+/**
+ * Return the amount of compares made by the last add, search or delete
+*/
+int bst_compares(BST);
+
+
 /**
  * Travel the binary search tree in some order
 */
@@ -148,6 +156,8 @@ typedef struct _AVL {
   FunctionCompare compare;
   FunctionVisit visit;
 
+  int compares; /* Compares made by the last operation */
+
 } *AVL;
 
 
@@ -181,6 +191,12 @@ int avl_search_bool(AVL, void*);
 void avl_delete(AVL, void*);
 
 
+/**
+ * Return the amount of compares made by the last add, search or delete
+*/
+int avl_compares(AVL);
+
+
 /**
  * Print the avl tree
 */